@@ -0,0 +1,42 @@
+#include "Arena.h"
+#include <cstring>
+#include <cstdint>
+
+namespace prs
+{
+    Arena::Arena(size_t blockSize)
+        : blockSize(blockSize) { }
+
+    void* Arena::Allocate(size_t size, size_t alignment)
+    {
+        size_t padding = (alignment - reinterpret_cast<std::uintptr_t>(current) % alignment) % alignment;
+        if (current == nullptr || padding + size > remaining)
+        {
+            size_t capacity = size + alignment > blockSize ? size + alignment : blockSize;
+            blocks.push_back(std::make_unique<char[]>(capacity));
+            current = blocks.back().get();
+            remaining = capacity;
+            padding = (alignment - reinterpret_cast<std::uintptr_t>(current) % alignment) % alignment;
+        }
+        char* result = current + padding;
+        current = result + size;
+        remaining -= padding + size;
+        return result;
+    }
+
+    std::string_view Arena::Store(std::string_view string)
+    {
+        char* copy = static_cast<char*>(Allocate(string.size(), 1));
+        std::memcpy(copy, string.data(), string.size());
+        return std::string_view(copy, string.size());
+    }
+
+    void Arena::Reset()
+    {
+        if (blocks.empty())
+            return;
+        blocks.erase(blocks.begin() + 1, blocks.end());
+        current = blocks.front().get();
+        remaining = blockSize;
+    }
+}
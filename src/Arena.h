@@ -0,0 +1,45 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <vector>
+#include <memory>
+#include <string_view>
+#include <cstddef>
+
+namespace prs
+{
+    /*
+    * A bump allocator for results that outlive a single parser invocation, such as unescaped strings.
+    * Memory is only released when the arena is reset or destroyed, which invalidates everything allocated from it.
+    */
+    class Arena
+    {
+    private:
+        std::vector<std::unique_ptr<char[]>> blocks;
+        size_t blockSize;
+        char* current = nullptr;
+        size_t remaining = 0;
+    public:
+        explicit Arena(size_t blockSize = 64 * 1024);
+
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        /*
+        * Returns uninitialized memory of the specified size and alignment.
+        */
+        void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+        /*
+        * Returns a copy of a string that lives as long as the arena.
+        */
+        std::string_view Store(std::string_view string);
+
+        /*
+        * Releases everything allocated from the arena, keeping one block for reuse.
+        */
+        void Reset();
+    };
+}
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <chrono>
+#include <string>
+#include <iostream>
+#include <iomanip>
+
+/*
+*
+* Timing helpers shared by the benchmark programs. Each benchmark is a standalone program with its own main.
+*
+*/
+
+namespace prs::benchmark
+{
+    /*
+    * Prevents the compiler from discarding a result that is otherwise unused.
+    */
+    template<typename T>
+    inline void Keep(const T& value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "g"(&value) : "memory");
+#else
+        static const void* volatile sink;
+        sink = &value;
+#endif
+    }
+
+    /*
+    * Calls function once to warm up, then repeatedly for at least minimumSeconds, and returns the average seconds per call.
+    */
+    template<typename F>
+    inline double Time(F&& function, double minimumSeconds = 0.5)
+    {
+        using Clock = std::chrono::steady_clock;
+        function();
+        long long calls = 0;
+        auto start = Clock::now();
+        std::chrono::duration<double> elapsed(0);
+        do
+        {
+            function();
+            ++calls;
+            elapsed = Clock::now() - start;
+        } while (elapsed.count() < minimumSeconds);
+        return elapsed.count() / calls;
+    }
+
+    /*
+    * Prints the throughput of processing bytes in seconds.
+    */
+    inline void ReportThroughput(const std::string& name, double seconds, double bytes)
+    {
+        std::cout << std::left << std::setw(40) << name << std::right << std::fixed << std::setprecision(3)
+            << std::setw(10) << bytes / seconds / 1e9 << " GB/s\n";
+    }
+
+    /*
+    * Prints the rate of processing count items in seconds.
+    */
+    inline void ReportRate(const std::string& name, double seconds, double count, const std::string& unit)
+    {
+        std::cout << std::left << std::setw(40) << name << std::right << std::fixed << std::setprecision(0)
+            << std::setw(14) << count / seconds << " " << unit << "/s\n";
+    }
+}
+
+#endif
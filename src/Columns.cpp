@@ -0,0 +1,53 @@
+#include "Columns.h"
+
+namespace prs
+{
+    void StringColumn::Append(std::string_view value)
+    {
+        data.append(value);
+        offsets.push_back(static_cast<std::int64_t>(data.size()));
+    }
+
+    std::string_view StringColumn::Get(size_t index) const
+    {
+        std::int64_t begin = offsets[index];
+        return std::string_view(data.data() + begin, offsets[index + 1] - begin);
+    }
+
+    size_t StringColumn::Size() const
+    {
+        return offsets.size() - 1;
+    }
+
+    void StringColumn::Truncate(size_t size)
+    {
+        offsets.resize(size + 1);
+        data.resize(offsets.back());
+    }
+
+    Parser<size_t> Rows(std::initializer_list<std::shared_ptr<ColumnBase>> columns, const Parser<Void>& row)
+    {
+        std::vector<std::shared_ptr<ColumnBase>> c = columns;
+        return [c, row](const StringState& state, const std::string& string)
+        {
+            std::vector<size_t> sizes(c.size());
+            int position = state.position;
+            size_t count = 0;
+            while (position < static_cast<int>(string.length()))
+            {
+                for (size_t i = 0; i < c.size(); ++i)
+                    sizes[i] = c[i]->Size();
+                auto result = row(string, position);
+                if (!result.Success() || result.GetPosition() == position)
+                {
+                    for (size_t i = 0; i < c.size(); ++i)
+                        c[i]->Truncate(sizes[i]);
+                    break;
+                }
+                position = result.GetPosition();
+                ++count;
+            }
+            return Success(position, count);
+        };
+    }
+}
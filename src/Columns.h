@@ -0,0 +1,136 @@
+#ifndef COLUMNS_H
+#define COLUMNS_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <initializer_list>
+#include "Parser.h"
+
+/*
+*
+* Column buffers that field parsers append to directly, so repeated records are stored as one typed array per field
+* instead of as a vector of records.
+*
+*/
+
+namespace prs
+{
+    /*
+    * The interface used by Rows to undo the values appended by a record that failed to parse.
+    */
+    class ColumnBase
+    {
+    public:
+        virtual ~ColumnBase() = default;
+
+        virtual size_t Size() const = 0;
+
+        virtual void Truncate(size_t size) = 0;
+    };
+
+    /*
+    * A column of fixed-size values such as integers or floating-point numbers.
+    */
+    template<typename T>
+    class Column : public ColumnBase
+    {
+    private:
+        std::vector<T> values;
+    public:
+        void Append(T value)
+        {
+            values.push_back(std::move(value));
+        }
+
+        const std::vector<T>& Values() const
+        {
+            return values;
+        }
+
+        size_t Size() const override
+        {
+            return values.size();
+        }
+
+        void Truncate(size_t size) override
+        {
+            values.resize(size);
+        }
+    };
+
+    /*
+    * A column of strings stored as one character buffer and the offsets of the strings in it.
+    * String i occupies the characters from Offsets()[i] to Offsets()[i + 1].
+    */
+    class StringColumn : public ColumnBase
+    {
+    private:
+        std::vector<std::int64_t> offsets = { 0 };
+        std::string data;
+    public:
+        void Append(std::string_view value);
+
+        std::string_view Get(size_t index) const;
+
+        const std::vector<std::int64_t>& Offsets() const
+        {
+            return offsets;
+        }
+
+        const std::string& Data() const
+        {
+            return data;
+        }
+
+        size_t Size() const override;
+
+        void Truncate(size_t size) override;
+    };
+
+    /*
+    * Returns a parser that appends the result of the argument to a column.
+    */
+    template<typename T, typename U>
+    [[nodiscard]]
+    inline Parser<Void> Into(const std::shared_ptr<Column<T>>& column, const Parser<U>& parser)
+    {
+        return [=](const StringState& state, const std::string& string)
+        {
+            auto result = parser(string, state.position);
+            if (!result.Success())
+                return Fail<Void>(state.position);
+            column->Append(static_cast<T>(std::move(result.GetResult())));
+            return Success(result.GetPosition(), Void());
+        };
+    }
+
+    /*
+    * Returns a parser that appends the result of the argument to a string column.
+    */
+    template<typename U>
+    [[nodiscard]]
+    inline Parser<Void> Into(const std::shared_ptr<StringColumn>& column, const Parser<U>& parser)
+    {
+        return [=](const StringState& state, const std::string& string)
+        {
+            auto result = parser(string, state.position);
+            if (!result.Success())
+                return Fail<Void>(state.position);
+            column->Append(std::string_view(result.GetResult()));
+            return Success(result.GetPosition(), Void());
+        };
+    }
+
+    /*
+    * Returns a parser that applies a record parser as many times as possible and returns the number of records.
+    * Stops at the end of the input or at a record that fails to parse or consumes no input,
+    * whose values are removed from the columns again.
+    */
+    [[nodiscard]]
+    Parser<size_t> Rows(std::initializer_list<std::shared_ptr<ColumnBase>> columns, const Parser<Void>& row);
+}
+
+#endif
@@ -0,0 +1,104 @@
+#include "Coroutine.h"
+#include <vector>
+#include <memory>
+
+namespace prs
+{
+    namespace
+    {
+        constexpr size_t alignment = 16;
+        constexpr size_t none = static_cast<size_t>(-1);
+        constexpr size_t minimumBlockSize = 64 * 1024;
+
+        static_assert(alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "Blocks must be allocated with the alignment of frames.");
+
+        /*
+        * Precedes every frame and links it to the frame allocated before it in the same block.
+        */
+        struct alignas(alignment) FrameHeader
+        {
+            size_t previous;
+            bool freed;
+        };
+
+        struct Block
+        {
+            std::unique_ptr<char[]> data;
+            size_t capacity;
+            size_t used = 0;
+            size_t last = none;
+        };
+
+        /*
+        * A stack of blocks per thread. Frames are normally freed in reverse order,
+        * but a frame freed out of order is only marked and reclaimed once the frames above it are gone.
+        */
+        class FrameStack
+        {
+        private:
+            std::vector<Block> blocks;
+            size_t current = 0;
+        public:
+            void* Allocate(size_t size)
+            {
+                size_t total = sizeof(FrameHeader) + (size + alignment - 1) / alignment * alignment;
+                while (current < blocks.size() && blocks[current].used + total > blocks[current].capacity)
+                {
+                    if (blocks[current].last == none)
+                        blocks.erase(blocks.begin() + current);
+                    else
+                        ++current;
+                }
+                if (current == blocks.size())
+                {
+                    size_t capacity = total > minimumBlockSize ? total : minimumBlockSize;
+                    blocks.push_back(Block{ std::make_unique<char[]>(capacity), capacity });
+                }
+
+                Block& block = blocks[current];
+                auto* header = reinterpret_cast<FrameHeader*>(block.data.get() + block.used);
+                header->previous = block.last;
+                header->freed = false;
+                block.last = block.used;
+                block.used += total;
+                return header + 1;
+            }
+
+            void Free(void* frame)
+            {
+                static_cast<FrameHeader*>(frame)[-1].freed = true;
+                while (true)
+                {
+                    Block& block = blocks[current];
+                    if (block.last == none)
+                    {
+                        if (current == 0)
+                            return;
+                        --current;
+                        continue;
+                    }
+                    auto* header = reinterpret_cast<FrameHeader*>(block.data.get() + block.last);
+                    if (!header->freed)
+                        return;
+                    block.used = block.last;
+                    block.last = header->previous;
+                }
+            }
+        };
+
+        thread_local FrameStack frames;
+    }
+
+    namespace detail
+    {
+        void* AllocateFrame(size_t size)
+        {
+            return frames.Allocate(size);
+        }
+
+        void FreeFrame(void* frame)
+        {
+            frames.Free(frame);
+        }
+    }
+}
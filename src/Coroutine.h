@@ -0,0 +1,188 @@
+#ifndef COROUTINE_H
+#define COROUTINE_H
+
+#include <string>
+#include <optional>
+#include <coroutine>
+#include <exception>
+#include <utility>
+#include <cstddef>
+#include "Parser.h"
+
+/*
+*
+* Support for writing sequential parsers as straight-line C++20 coroutines:
+*
+*     auto keyValue = prs::Coroutine([]() -> prs::Coro<prs::Pair<std::string, int>>
+*     {
+*         auto key = co_await prs::letters;
+*         co_await prs::Char('=');
+*         auto value = co_await prs::integer;
+*         co_return { key, value };
+*     });
+*
+* Each co_await runs a parser at the current position. When it fails, the coroutine is abandoned
+* and the whole parser fails at the position it started at, so no explicit backtracking is needed.
+* GCC 12 mis-destroys some class temporaries built in the operand of a co_await inside a loop,
+* so parsers with such arguments are best built once outside the coroutine.
+*
+*/
+
+namespace prs
+{
+    namespace detail
+    {
+        /*
+        * Allocates coroutine frames from a per-thread stack of memory blocks.
+        * Frames of nested coroutine parsers are released in the reverse order of their allocation, which makes this a bump allocation.
+        */
+        void* AllocateFrame(size_t size);
+
+        void FreeFrame(void* frame);
+    }
+
+    /*
+    * The return type of a coroutine that parses a T.
+    */
+    template<typename T>
+    class Coro
+    {
+    public:
+        using ValueType = T;
+
+        struct promise_type
+        {
+            const std::string* string = nullptr;
+            int position = 0;
+            bool failed = false;
+            std::optional<T> value;
+            std::exception_ptr exception;
+
+            template<typename U>
+            struct Awaiter
+            {
+                promise_type* promise;
+                const Parser<U>* parser;
+                std::optional<U> result;
+
+                bool await_ready()
+                {
+                    auto parseResult = (*parser)(*promise->string, promise->position);
+                    if (!parseResult.Success())
+                    {
+                        promise->failed = true;
+                        return false;
+                    }
+                    promise->position = parseResult.GetPosition();
+                    result.emplace(std::move(parseResult.GetResult()));
+                    return true;
+                }
+
+                /*
+                * Only reached on failure. The coroutine stays suspended and is destroyed by its parser.
+                */
+                void await_suspend(std::coroutine_handle<>) noexcept { }
+
+                U await_resume()
+                {
+                    return std::move(*result);
+                }
+            };
+
+            Coro get_return_object()
+            {
+                return Coro(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+
+            std::suspend_always initial_suspend() noexcept
+            {
+                return {};
+            }
+
+            std::suspend_always final_suspend() noexcept
+            {
+                return {};
+            }
+
+            void return_value(T result)
+            {
+                value.emplace(std::move(result));
+            }
+
+            void unhandled_exception()
+            {
+                exception = std::current_exception();
+            }
+
+            template<typename U>
+            Awaiter<U> await_transform(const Parser<U>& parser)
+            {
+                return Awaiter<U>{ this, &parser, std::nullopt };
+            }
+
+            static void* operator new(size_t size)
+            {
+                return detail::AllocateFrame(size);
+            }
+
+            static void operator delete(void* frame)
+            {
+                detail::FreeFrame(frame);
+            }
+        };
+    private:
+        std::coroutine_handle<promise_type> handle;
+    public:
+        explicit Coro(std::coroutine_handle<promise_type> handle)
+            : handle(handle) { }
+
+        Coro(Coro&& other) noexcept
+            : handle(std::exchange(other.handle, nullptr)) { }
+
+        Coro(const Coro&) = delete;
+        Coro& operator=(const Coro&) = delete;
+        Coro& operator=(Coro&&) = delete;
+
+        ~Coro()
+        {
+            if (handle)
+                handle.destroy();
+        }
+
+        /*
+        * Runs the coroutine on an input beginning at a specified position.
+        */
+        ParseResult<T> Run(const std::string& string, int position)
+        {
+            promise_type& promise = handle.promise();
+            promise.string = &string;
+            promise.position = position;
+            handle.resume();
+            if (promise.exception)
+                std::rethrow_exception(promise.exception);
+            if (promise.failed || !promise.value.has_value())
+                return Fail<T>(position);
+            return Success(promise.position, std::move(*promise.value));
+        }
+    };
+
+    /*
+    * Returns a parser that runs a new coroutine created by function every time it is invoked.
+    * The function is typically a capture-less lambda returning Coro<T>.
+    */
+    template<typename F>
+    [[nodiscard]]
+    inline auto Coroutine(F function)
+    {
+        using ReturnType = typename decltype(function())::ValueType;
+
+        Parser<ReturnType> p = [function](const StringState& state, const std::string& string)
+        {
+            auto coroutine = function();
+            return coroutine.Run(string, state.position);
+        };
+        return p;
+    }
+}
+
+#endif
@@ -0,0 +1,35 @@
+#include <string>
+#include "Parser.h"
+#include "Coroutine.h"
+#include "Benchmark.h"
+
+/*
+* Compares a key=value parser written as a coroutine with the same grammar written with operator>>.
+*/
+int main()
+{
+    using namespace prs;
+
+    Parser<Pair<std::string, int>> chained = letters >> ~Char('=') >> integer;
+    auto coroutine = Coroutine([]() -> Coro<Pair<std::string, int>>
+    {
+        auto key = co_await letters;
+        co_await Char('=');
+        auto value = co_await integer;
+        co_return Pair<std::string, int>{ key, value };
+    });
+
+    std::string input = "timeout=1500";
+    const double count = 10000;
+    auto run = [&](const Parser<Pair<std::string, int>>& parser)
+    {
+        return benchmark::Time([&]()
+        {
+            for (int i = 0; i < count; ++i)
+                benchmark::Keep(parser(input));
+        });
+    };
+    benchmark::ReportRate("operator>>", run(chained), count, "parses");
+    benchmark::ReportRate("Coroutine", run(coroutine), count, "parses");
+    return 0;
+}
@@ -0,0 +1,189 @@
+#include "Csv.h"
+#include "Fields.h"
+#include "Strings.h"
+#include <cstring>
+#include <algorithm>
+
+namespace prs
+{
+    namespace
+    {
+        /*
+        * Inputs shorter than this per worker are parsed on the calling thread.
+        */
+        constexpr int minimumChunk = 1 << 20;
+
+        /*
+        * Returns the text of a field located by SplitRecord, without its quotes.
+        */
+        std::string_view Unquote(const std::string& string, const Span& span, char quote, const Parser<std::string_view>& quoted)
+        {
+            const char* data = string.data();
+            int length = span.end - span.begin;
+            if (length == 0 || data[span.begin] != quote)
+                return std::string_view(data + span.begin, length);
+            if (std::memchr(data + span.begin + 1, quote, length - 2) == nullptr)
+                return std::string_view(data + span.begin + 1, length - 2);
+            return quoted(string, span.begin).GetResult();
+        }
+
+        /*
+        * Appends the records in [begin, end) to records. Fails if a record is malformed or extends past end.
+        */
+        bool ParseRecords(const std::string& string, int begin, int end, char delimiter, char quote,
+            const Parser<std::string_view>& quoted, std::vector<std::vector<std::string_view>>& records)
+        {
+            int position = begin;
+            while (position < end)
+            {
+                std::vector<std::string_view>& fields = records.emplace_back();
+                auto store = [&](int, const Span& span)
+                {
+                    fields.push_back(Unquote(string, span, quote, quoted));
+                };
+                if (detail::SplitRecord(string, position, delimiter, quote, store, position) < 0 || position > end)
+                    return false;
+            }
+            return true;
+        }
+    }
+
+    Parser<std::vector<std::string_view>> CsvRecord(const std::shared_ptr<Arena>& arena, char delimiter, char quote)
+    {
+        Parser<std::string_view> quoted = QuotedString(arena, quote, quote, EscapePolicy::DoubledQuote);
+        return [=](const StringState& state, const std::string& string)
+        {
+            if (state.position >= static_cast<int>(string.length()))
+                return Fail<std::vector<std::string_view>>(state.position);
+            std::vector<std::string_view> fields;
+            auto store = [&](int, const Span& span)
+            {
+                fields.push_back(Unquote(string, span, quote, quoted));
+            };
+            int next;
+            if (detail::SplitRecord(string, state.position, delimiter, quote, store, next) < 0)
+                return Fail<std::vector<std::string_view>>(state.position);
+            return Success(next, std::move(fields));
+        };
+    }
+
+    Parser<std::vector<std::vector<std::string_view>>> Csv(const std::shared_ptr<Arena>& arena, char delimiter, char quote)
+    {
+        Parser<std::string_view> quoted = QuotedString(arena, quote, quote, EscapePolicy::DoubledQuote);
+        return [=](const StringState& state, const std::string& string)
+        {
+            std::vector<std::vector<std::string_view>> records;
+            int length = static_cast<int>(string.length());
+            if (!ParseRecords(string, state.position, length, delimiter, quote, quoted, records))
+                return Fail<std::vector<std::vector<std::string_view>>>(state.position);
+            return Success(length, std::move(records));
+        };
+    }
+
+    Parser<std::vector<std::vector<std::string_view>>> ParallelCsv(const std::shared_ptr<Arena>& arena, ThreadPool& pool,
+        char delimiter, char quote)
+    {
+        Parser<std::vector<std::vector<std::string_view>>> sequential = Csv(arena, delimiter, quote);
+        ThreadPool* threads = &pool;
+        return [=](const StringState& state, const std::string& string)
+        {
+            using Records = std::vector<std::vector<std::string_view>>;
+            const char* data = string.data();
+            int length = static_cast<int>(string.length());
+            size_t count = std::min<size_t>((threads->Size() + 1) * 4, (length - state.position) / minimumChunk);
+            if (count < 2)
+                return sequential(string, state.position);
+
+            // Quotes are counted in equal parts of the input first, so that each part knows whether it starts
+            // inside a quoted field and can move its start to the next line break outside of quotes.
+            std::vector<int> starts(count + 1);
+            std::vector<size_t> quotes(count);
+            for (size_t i = 0; i < count; ++i)
+                starts[i] = state.position + static_cast<int>(static_cast<std::int64_t>(length - state.position) * i / count);
+            starts[count] = length;
+            threads->ForEach(count, [&](size_t i)
+            {
+                quotes[i] = std::count(data + starts[i], data + starts[i + 1], quote);
+            });
+            size_t parity = 0;
+            for (size_t i = 1; i < count; ++i)
+            {
+                parity += quotes[i - 1];
+                bool quoted = parity % 2 != 0;
+                int position = starts[i];
+                while (position < length && (quoted || data[position] != '\n'))
+                {
+                    if (data[position] == quote)
+                        quoted = !quoted;
+                    ++position;
+                }
+                starts[i] = std::max(starts[i - 1], std::min(position + 1, length));
+            }
+
+            // An arena is not thread-safe, so each chunk unescapes into its own,
+            // and the unescaped fields are copied to the shared arena when the chunks are joined.
+            std::vector<Records> chunks(count);
+            std::vector<std::shared_ptr<Arena>> arenas(count);
+            std::vector<char> succeeded(count);
+            threads->ForEach(count, [&](size_t i)
+            {
+                arenas[i] = std::make_shared<Arena>();
+                Parser<std::string_view> quoted = QuotedString(arenas[i], quote, quote, EscapePolicy::DoubledQuote);
+                succeeded[i] = ParseRecords(string, starts[i], starts[i + 1], delimiter, quote, quoted, chunks[i]);
+            });
+            if (std::find(succeeded.begin(), succeeded.end(), 0) != succeeded.end())
+                return Fail<Records>(state.position);
+
+            size_t total = 0;
+            for (const Records& chunk : chunks)
+                total += chunk.size();
+            Records records;
+            records.reserve(total);
+            for (Records& chunk : chunks)
+            {
+                for (auto& fields : chunk)
+                {
+                    for (std::string_view& field : fields)
+                        if (field.data() < data || field.data() > data + length)
+                            field = arena->Store(field);
+                    records.push_back(std::move(fields));
+                }
+            }
+            return Success(length, std::move(records));
+        };
+    }
+
+    Parser<size_t> CsvColumns(const std::vector<std::shared_ptr<StringColumn>>& columns, char delimiter, char quote)
+    {
+        auto scratch = std::make_shared<Arena>();
+        Parser<std::string_view> quoted = QuotedString(scratch, quote, quote, EscapePolicy::DoubledQuote);
+        int count = static_cast<int>(columns.size());
+        return [=](const StringState& state, const std::string& string)
+        {
+            int position = state.position;
+            size_t rows = 0;
+            while (position < static_cast<int>(string.length()))
+            {
+                int fields = 0;
+                auto store = [&](int index, const Span& span)
+                {
+                    if (index < count)
+                        columns[index]->Append(Unquote(string, span, quote, quoted));
+                    ++fields;
+                };
+                int next = position;
+                int found = detail::SplitRecord(string, position, delimiter, quote, store, next);
+                scratch->Reset();
+                if (found != count)
+                {
+                    for (int i = 0; i < count && i < fields; ++i)
+                        columns[i]->Truncate(columns[i]->Size() - 1);
+                    break;
+                }
+                position = next;
+                ++rows;
+            }
+            return Success(position, rows);
+        };
+    }
+}
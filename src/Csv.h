@@ -0,0 +1,53 @@
+#ifndef CSV_H
+#define CSV_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include "Parser.h"
+#include "Arena.h"
+#include "Columns.h"
+#include "ThreadPool.h"
+
+/*
+*
+* Parsers for RFC 4180 CSV. Records end with LF or CRLF, and fields may be quoted, where two quotes in a row stand for one quote.
+* Quoted fields may contain delimiters and line breaks.
+*
+*/
+
+namespace prs
+{
+    /*
+    * Returns a parser for one record, which returns its fields with the quotes removed.
+    * Unquoted fields and quoted fields without doubled quotes are views into the input, other fields are unescaped into the arena.
+    */
+    [[nodiscard]]
+    Parser<std::vector<std::string_view>> CsvRecord(const std::shared_ptr<Arena>& arena, char delimiter = ',', char quote = '"');
+
+    /*
+    * Returns a parser for records up to the end of the input, which returns the fields of each record.
+    * A line break at the end of the last record is optional. Fails if any record is malformed.
+    */
+    [[nodiscard]]
+    Parser<std::vector<std::vector<std::string_view>>> Csv(const std::shared_ptr<Arena>& arena, char delimiter = ',', char quote = '"');
+
+    /*
+    * Like Csv, but splits large inputs into chunks at record boundaries and parses the chunks on the threads of a pool.
+    * Record boundaries are found by counting quotes, so quotes must only appear in quoted fields, as RFC 4180 requires.
+    * The calling thread parses chunks as well, so it may itself be a worker of the pool.
+    */
+    [[nodiscard]]
+    Parser<std::vector<std::vector<std::string_view>>> ParallelCsv(const std::shared_ptr<Arena>& arena,
+        ThreadPool& pool = ThreadPool::Shared(), char delimiter = ',', char quote = '"');
+
+    /*
+    * Returns a parser that appends field i of each record to columns[i] and returns the number of records.
+    * Parsing stops at the first record that is malformed or does not have one field per column, and nothing of that record is appended.
+    */
+    [[nodiscard]]
+    Parser<size_t> CsvColumns(const std::vector<std::shared_ptr<StringColumn>>& columns, char delimiter = ',', char quote = '"');
+}
+
+#endif
@@ -0,0 +1,86 @@
+#include <string>
+#include <vector>
+#include <memory>
+#include <random>
+#include <iostream>
+#include "Csv.h"
+#include "Benchmark.h"
+
+/*
+* Measures the CSV parsers on a narrow file with few short fields per record and a wide file with many fields,
+* row-wise on one thread, row-wise on a thread pool and columnar on one thread.
+*/
+
+namespace
+{
+    std::mt19937 generator(7);
+
+    std::string Field(int column)
+    {
+        switch (column % 4)
+        {
+        case 0:
+            return std::to_string(generator() % 1000000);
+        case 1:
+            return std::to_string(generator() % 100000) + "." + std::to_string(generator() % 100);
+        case 2:
+            return "name" + std::to_string(generator() % 1000);
+        default:
+            return generator() % 8 == 0 ? "\"quoted, with \"\"escapes\"\"\"" : "\"quoted text\"";
+        }
+    }
+
+    std::string File(int columns, size_t size)
+    {
+        std::string file;
+        while (file.size() < size)
+        {
+            for (int i = 0; i < columns; ++i)
+            {
+                if (i > 0)
+                    file += ',';
+                file += Field(i);
+            }
+            file += '\n';
+        }
+        return file;
+    }
+}
+
+int main()
+{
+    using namespace prs;
+
+    ThreadPool& pool = ThreadPool::Shared();
+    std::cout << "threads: " << pool.Size() << "\n";
+    std::pair<const char*, int> shapes[] = { { "narrow", 4 }, { "wide", 40 } };
+    for (const auto& [name, columns] : shapes)
+    {
+        std::string file = File(columns, 64 << 20);
+        double bytes = static_cast<double>(file.size());
+        auto arena = std::make_shared<Arena>();
+
+        auto rows = Csv(arena);
+        benchmark::ReportThroughput(std::string(name) + " rows, single thread", benchmark::Time([&]()
+        {
+            benchmark::Keep(rows(file));
+            arena->Reset();
+        }), bytes);
+
+        auto parallel = ParallelCsv(arena, pool);
+        benchmark::ReportThroughput(std::string(name) + " rows, thread pool", benchmark::Time([&]()
+        {
+            benchmark::Keep(parallel(file));
+            arena->Reset();
+        }), bytes);
+
+        benchmark::ReportThroughput(std::string(name) + " columns, single thread", benchmark::Time([&]()
+        {
+            std::vector<std::shared_ptr<StringColumn>> strings;
+            for (int i = 0; i < columns; ++i)
+                strings.push_back(std::make_shared<StringColumn>());
+            benchmark::Keep(CsvColumns(strings)(file));
+        }), bytes);
+    }
+    return 0;
+}
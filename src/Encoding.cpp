@@ -0,0 +1,274 @@
+#include "Encoding.h"
+#include "Scan.h"
+#include <array>
+
+namespace prs
+{
+    namespace
+    {
+        constexpr std::uint8_t invalid = 0xFF;
+
+        constexpr std::array<std::uint8_t, 256> MakeHexTable()
+        {
+            std::array<std::uint8_t, 256> table{};
+            for (auto& value : table)
+                value = invalid;
+            for (int i = 0; i < 10; ++i)
+                table['0' + i] = static_cast<std::uint8_t>(i);
+            for (int i = 0; i < 6; ++i)
+            {
+                table['a' + i] = static_cast<std::uint8_t>(10 + i);
+                table['A' + i] = static_cast<std::uint8_t>(10 + i);
+            }
+            return table;
+        }
+
+        constexpr std::array<std::uint8_t, 256> MakeBase64Table(char c62, char c63)
+        {
+            std::array<std::uint8_t, 256> table{};
+            for (auto& value : table)
+                value = invalid;
+            for (int i = 0; i < 26; ++i)
+            {
+                table['A' + i] = static_cast<std::uint8_t>(i);
+                table['a' + i] = static_cast<std::uint8_t>(26 + i);
+            }
+            for (int i = 0; i < 10; ++i)
+                table['0' + i] = static_cast<std::uint8_t>(52 + i);
+            table[static_cast<unsigned char>(c62)] = 62;
+            table[static_cast<unsigned char>(c63)] = 63;
+            return table;
+        }
+
+        /*
+        * A base64 alphabet, which differs between its variants only in the characters for 62 and 63.
+        */
+        struct Base64Alphabet
+        {
+            std::array<std::uint8_t, 256> table;
+            char c62;
+            char c63;
+        };
+
+        constexpr auto hexTable = MakeHexTable();
+        constexpr Base64Alphabet base64Alphabet{ MakeBase64Table('+', '/'), '+', '/' };
+        constexpr Base64Alphabet base64UrlAlphabet{ MakeBase64Table('-', '_'), '-', '_' };
+
+        std::uint8_t Lookup(const std::array<std::uint8_t, 256>& table, char c)
+        {
+            return table[static_cast<unsigned char>(c)];
+        }
+
+#ifdef PRS_SSE2
+        /*
+        * Returns a mask of the characters of chunk between low and high, which must both be ASCII.
+        */
+        __m128i InRange(__m128i chunk, char low, char high)
+        {
+            return _mm_and_si128(_mm_cmpgt_epi8(chunk, _mm_set1_epi8(static_cast<char>(low - 1))),
+                _mm_cmplt_epi8(chunk, _mm_set1_epi8(static_cast<char>(high + 1))));
+        }
+#endif
+
+        /*
+        * Decodes sixteen hexadecimal digits into eight bytes, or returns false if any of the characters is not a digit.
+        */
+        bool DecodeHexBlock(const char* p, std::uint8_t* out)
+        {
+#ifdef PRS_SSE2
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            __m128i digits = InRange(chunk, '0', '9');
+            __m128i letters = InRange(_mm_or_si128(chunk, _mm_set1_epi8(0x20)), 'a', 'f');
+            if (_mm_movemask_epi8(_mm_or_si128(digits, letters)) != 0xFFFF)
+                return false;
+            // The low four bits of a digit are its value, and those of a letter are its value minus 9.
+            __m128i nibbles = _mm_add_epi8(_mm_and_si128(chunk, _mm_set1_epi8(0x0F)), _mm_and_si128(letters, _mm_set1_epi8(9)));
+            // Each 16-bit lane holds the high nibble of a byte in its low half and the low nibble in its high half.
+            __m128i pairs = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(nibbles, _mm_set1_epi16(0x00FF)), 4), _mm_srli_epi16(nibbles, 8));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(pairs, pairs));
+            return true;
+#else
+            std::uint8_t nibbles[16];
+            std::uint8_t bad = 0;
+            for (int i = 0; i < 16; ++i)
+            {
+                nibbles[i] = Lookup(hexTable, p[i]);
+                bad |= nibbles[i];
+            }
+            if (bad & 0xF0)
+                return false;
+            for (int i = 0; i < 8; ++i)
+                out[i] = static_cast<std::uint8_t>((nibbles[2 * i] << 4) | nibbles[2 * i + 1]);
+            return true;
+#endif
+        }
+
+        /*
+        * Decodes sixteen base64 characters into twelve bytes, or returns false if any of the characters is not in the alphabet.
+        */
+        bool DecodeBase64Block(const Base64Alphabet& alphabet, const char* p, std::uint8_t* out)
+        {
+#ifdef PRS_SSE2
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            __m128i upper = InRange(chunk, 'A', 'Z');
+            __m128i lower = InRange(chunk, 'a', 'z');
+            __m128i digits = InRange(chunk, '0', '9');
+            __m128i is62 = _mm_cmpeq_epi8(chunk, _mm_set1_epi8(alphabet.c62));
+            __m128i is63 = _mm_cmpeq_epi8(chunk, _mm_set1_epi8(alphabet.c63));
+            __m128i valid = _mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(digits, _mm_or_si128(is62, is63)));
+            if (_mm_movemask_epi8(valid) != 0xFFFF)
+                return false;
+            // Each class of characters is mapped to its sextets by adding one offset modulo 256.
+            __m128i offsets = _mm_or_si128(
+                _mm_or_si128(_mm_and_si128(upper, _mm_set1_epi8(static_cast<char>(-'A'))),
+                    _mm_and_si128(lower, _mm_set1_epi8(static_cast<char>(26 - 'a')))),
+                _mm_or_si128(_mm_and_si128(digits, _mm_set1_epi8(static_cast<char>(52 - '0'))),
+                    _mm_or_si128(_mm_and_si128(is62, _mm_set1_epi8(static_cast<char>(62 - alphabet.c62))),
+                        _mm_and_si128(is63, _mm_set1_epi8(static_cast<char>(63 - alphabet.c63))))));
+            __m128i sextets = _mm_add_epi8(chunk, offsets);
+            // Pairs of sextets are merged into 12-bit values, and pairs of those into 24-bit groups, the first character being most significant.
+            __m128i pairs = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(sextets, _mm_set1_epi16(0x00FF)), 6), _mm_srli_epi16(sextets, 8));
+            __m128i groups = _mm_or_si128(_mm_slli_epi32(_mm_and_si128(pairs, _mm_set1_epi32(0xFFFF)), 12), _mm_srli_epi32(pairs, 16));
+            alignas(16) std::uint32_t values[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(values), groups);
+#else
+            std::uint8_t sextets[16];
+            std::uint8_t bad = 0;
+            for (int i = 0; i < 16; ++i)
+            {
+                sextets[i] = Lookup(alphabet.table, p[i]);
+                bad |= sextets[i];
+            }
+            if (bad & 0xC0)
+                return false;
+            std::uint32_t values[4];
+            for (int i = 0; i < 4; ++i)
+                values[i] = (sextets[4 * i] << 18) | (sextets[4 * i + 1] << 12) | (sextets[4 * i + 2] << 6) | sextets[4 * i + 3];
+#endif
+            for (int i = 0; i < 4; ++i)
+            {
+                out[3 * i] = static_cast<std::uint8_t>(values[i] >> 16);
+                out[3 * i + 1] = static_cast<std::uint8_t>(values[i] >> 8);
+                out[3 * i + 2] = static_cast<std::uint8_t>(values[i]);
+            }
+            return true;
+        }
+
+        ParseResult<std::vector<std::uint8_t>> DecodeHex(const StringState& state, const std::string& string)
+        {
+            const char* begin = string.data() + state.position;
+            const char* end = string.data() + string.length();
+            const char* p = begin;
+            std::vector<std::uint8_t> bytes;
+
+            while (end - p >= 16)
+            {
+                size_t size = bytes.size();
+                bytes.resize(size + 8);
+                if (!DecodeHexBlock(p, bytes.data() + size))
+                {
+                    bytes.resize(size);
+                    break;
+                }
+                p += 16;
+            }
+
+            while (end - p >= 2)
+            {
+                std::uint8_t high = Lookup(hexTable, p[0]);
+                std::uint8_t low = Lookup(hexTable, p[1]);
+                if (high == invalid || low == invalid)
+                    break;
+                bytes.push_back(static_cast<std::uint8_t>((high << 4) | low));
+                p += 2;
+            }
+
+            int position = static_cast<int>(p - string.data());
+            if (p < end && Lookup(hexTable, *p) != invalid)
+                return Fail<std::vector<std::uint8_t>>(position);
+            if (bytes.empty())
+                return Fail<std::vector<std::uint8_t>>(state.position);
+            return Success(position, std::move(bytes));
+        }
+
+        ParseResult<std::vector<std::uint8_t>> DecodeBase64(const Base64Alphabet& alphabet,
+            const StringState& state, const std::string& string)
+        {
+            const char* begin = string.data() + state.position;
+            const char* end = string.data() + string.length();
+            const char* p = begin;
+            std::vector<std::uint8_t> bytes;
+
+            while (end - p >= 16)
+            {
+                size_t size = bytes.size();
+                bytes.resize(size + 12);
+                if (!DecodeBase64Block(alphabet, p, bytes.data() + size))
+                {
+                    bytes.resize(size);
+                    break;
+                }
+                p += 16;
+            }
+
+            std::uint32_t group = 0;
+            int count = 0;
+            while (p < end)
+            {
+                std::uint8_t sextet = Lookup(alphabet.table, *p);
+                if (sextet == invalid)
+                    break;
+                group = (group << 6) | sextet;
+                ++p;
+                if (++count == 4)
+                {
+                    bytes.push_back(static_cast<std::uint8_t>(group >> 16));
+                    bytes.push_back(static_cast<std::uint8_t>(group >> 8));
+                    bytes.push_back(static_cast<std::uint8_t>(group));
+                    group = 0;
+                    count = 0;
+                }
+            }
+
+            int position = static_cast<int>(p - string.data());
+            if (count == 1)
+                return Fail<std::vector<std::uint8_t>>(position - 1);
+            if (count == 0)
+            {
+                if (p < end && *p == '=')
+                    return Fail<std::vector<std::uint8_t>>(position);
+            }
+            else
+            {
+                int padding = 0;
+                while (p + padding < end && p[padding] == '=' && count + padding < 4)
+                    ++padding;
+                if (padding > 0 && count + padding != 4)
+                    return Fail<std::vector<std::uint8_t>>(position + padding);
+                position += padding;
+                group <<= 6 * (4 - count);
+                bytes.push_back(static_cast<std::uint8_t>(group >> 16));
+                if (count == 3)
+                    bytes.push_back(static_cast<std::uint8_t>(group >> 8));
+            }
+            if (bytes.empty())
+                return Fail<std::vector<std::uint8_t>>(state.position);
+            return Success(position, std::move(bytes));
+        }
+    }
+
+    Parser<std::vector<std::uint8_t>> hexBytes = [](const StringState& state, const std::string& string)
+    {
+        return DecodeHex(state, string);
+    };
+
+    Parser<std::vector<std::uint8_t>> base64Bytes = [](const StringState& state, const std::string& string)
+    {
+        return DecodeBase64(base64Alphabet, state, string);
+    };
+
+    Parser<std::vector<std::uint8_t>> base64UrlBytes = [](const StringState& state, const std::string& string)
+    {
+        return DecodeBase64(base64UrlAlphabet, state, string);
+    };
+}
@@ -0,0 +1,34 @@
+#ifndef ENCODING_H
+#define ENCODING_H
+
+#include <vector>
+#include <cstdint>
+#include "Parser.h"
+
+/*
+*
+* Parsers that decode binary data embedded in text. Each parser consumes the longest run of characters of its alphabet
+* and decodes it in the same pass, sixteen characters at a time with SSE2 where it is available while no invalid character is in sight.
+* Unlike other parsers, these report the position of the first offending character when a run is malformed.
+*
+*/
+
+namespace prs
+{
+    /*
+    * Parses a non-empty even number of hexadecimal digits of either case.
+    */
+    extern Parser<std::vector<std::uint8_t>> hexBytes;
+
+    /*
+    * Parses non-empty base64 with the standard alphabet of RFC 4648. Padding with '=' is optional but must be correct when present.
+    */
+    extern Parser<std::vector<std::uint8_t>> base64Bytes;
+
+    /*
+    * Parses non-empty base64 with the URL and filename safe alphabet of RFC 4648.
+    */
+    extern Parser<std::vector<std::uint8_t>> base64UrlBytes;
+}
+
+#endif
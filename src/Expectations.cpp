@@ -0,0 +1,49 @@
+#include "Expectations.h"
+#include <algorithm>
+#include <bit>
+
+namespace prs
+{
+    Symbol Expectations::Intern(std::string_view label)
+    {
+        Symbol symbol = labels.Intern(label);
+        expected.resize((labels.Size() + 63) / 64, 0);
+        return symbol;
+    }
+
+    std::vector<std::string_view> Expectations::Expected() const
+    {
+        std::vector<std::string_view> result;
+        for (size_t word = 0; word < expected.size(); ++word)
+            for (std::uint64_t bits = expected[word]; bits != 0; bits &= bits - 1)
+                result.push_back(labels.Name(static_cast<Symbol>(word * 64 + std::countr_zero(bits))));
+        return result;
+    }
+
+    std::string Expectations::Describe(const std::string& string) const
+    {
+        if (position < 0)
+            return "no errors";
+
+        int end = std::min(position, static_cast<int>(string.length()));
+        int line = 1 + static_cast<int>(std::count(string.begin(), string.begin() + end, '\n'));
+        size_t lineStart = end == 0 ? std::string::npos : string.rfind('\n', end - 1);
+        int column = lineStart == std::string::npos ? end + 1 : end - static_cast<int>(lineStart);
+
+        std::string message = "line " + std::to_string(line) + ", column " + std::to_string(column) + ": expected ";
+        auto names = Expected();
+        for (size_t i = 0; i < names.size(); ++i)
+        {
+            if (i > 0)
+                message += i + 1 == names.size() ? " or " : ", ";
+            message += names[i];
+        }
+        return message;
+    }
+
+    void Expectations::Clear()
+    {
+        std::fill(expected.begin(), expected.end(), 0);
+        position = -1;
+    }
+}
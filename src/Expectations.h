@@ -0,0 +1,90 @@
+#ifndef EXPECTATIONS_H
+#define EXPECTATIONS_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <algorithm>
+#include "Parser.h"
+#include "Symbols.h"
+
+namespace prs
+{
+    /*
+    * Tracks what was expected at the furthest position where a labelled parser failed, for error messages such as
+    * "expected identifier, number or '('". Labels are interned once, and the expected set is a bitset of label symbols
+    * that is reset when a failure occurs further into the input and merged with failures at the same position.
+    * Nothing is rendered until Describe is called.
+    */
+    class Expectations
+    {
+    private:
+        SymbolTable labels;
+        std::vector<std::uint64_t> expected;
+        int position = -1;
+    public:
+        /*
+        * Returns the symbol of a label, adding it if it is new.
+        */
+        Symbol Intern(std::string_view label);
+
+        /*
+        * Records that the labelled parser failed at a position.
+        */
+        void Expect(int failurePosition, Symbol label)
+        {
+            if (failurePosition < position)
+                return;
+            if (failurePosition > position)
+            {
+                std::fill(expected.begin(), expected.end(), 0);
+                position = failurePosition;
+            }
+            expected[label / 64] |= std::uint64_t(1) << (label % 64);
+        }
+
+        /*
+        * Returns the furthest position where a labelled parser failed, or -1 if none has.
+        */
+        int GetPosition() const
+        {
+            return position;
+        }
+
+        /*
+        * Returns the labels expected at the furthest failure position, in the order they were interned.
+        */
+        std::vector<std::string_view> Expected() const;
+
+        /*
+        * Returns a message such as "line 3, column 7: expected identifier, number or '('".
+        */
+        std::string Describe(const std::string& string) const;
+
+        /*
+        * Forgets the recorded failures, keeping the labels.
+        */
+        void Clear();
+    };
+
+    /*
+    * Returns a parser that records label as expected when parser fails. Successful parses only pay for one branch.
+    */
+    template<typename T>
+    [[nodiscard]]
+    inline Parser<T> Label(const std::shared_ptr<Expectations>& expectations, const Parser<T>& parser, std::string_view label)
+    {
+        Symbol symbol = expectations->Intern(label);
+        return [=](const StringState& state, const std::string& string)
+        {
+            auto result = parser(string, state.position);
+            if (!result.Success())
+                expectations->Expect(state.position, symbol);
+            return result;
+        };
+    }
+}
+
+#endif
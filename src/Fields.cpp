@@ -0,0 +1,25 @@
+#include "Fields.h"
+
+namespace prs
+{
+    Parser<std::vector<std::string_view>> FieldSpans(char delimiter, int count, char quote)
+    {
+        return [=](const StringState& state, const std::string& string)
+        {
+            if (state.position >= static_cast<int>(string.length()))
+                return Fail<std::vector<std::string_view>>(state.position);
+            std::vector<std::string_view> fields;
+            if (count >= 0)
+                fields.reserve(count);
+            auto store = [&](int, const Span& span)
+            {
+                fields.emplace_back(string.data() + span.begin, span.end - span.begin);
+            };
+            int next;
+            int found = detail::SplitRecord(string, state.position, delimiter, quote, store, next);
+            if (found < 0 || (count >= 0 && found != count))
+                return Fail<std::vector<std::string_view>>(state.position);
+            return Success(next, std::move(fields));
+        };
+    }
+}
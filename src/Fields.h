@@ -0,0 +1,172 @@
+#ifndef FIELDS_H
+#define FIELDS_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <tuple>
+#include <array>
+#include <optional>
+#include <utility>
+#include <type_traits>
+#include "Parser.h"
+#include "Scan.h"
+
+namespace prs
+{
+    namespace detail
+    {
+        /*
+        * Locates the fields of a record that ends with a line break or the end of the input, and calls onField with the span of each.
+        * A field starting with the quote character extends to the matching quote, where two quotes in a row stand for one quote,
+        * and its span includes the quotes. Sets next to the position after the line break.
+        * Returns the number of fields, or -1 if a quoted field is not closed or is followed by something other than a delimiter or line break.
+        */
+        template<typename F>
+        inline int SplitRecord(const std::string& string, int position, char delimiter, char quote, F&& onField, int& next)
+        {
+            const char* data = string.data();
+            int length = static_cast<int>(string.length());
+            int count = 0;
+            while (true)
+            {
+                int begin = position;
+                if (position < length && data[position] == quote)
+                {
+                    ++position;
+                    while (true)
+                    {
+                        position = static_cast<int>(scan::FindFirstOf(data + position, data + length, quote, quote) - data);
+                        if (position == length)
+                            return -1;
+                        if (position + 1 < length && data[position + 1] == quote)
+                            position += 2;
+                        else
+                            break;
+                    }
+                    ++position;
+                    if (position < length && data[position] != delimiter && data[position] != '\n' &&
+                        !(data[position] == '\r' && position + 1 < length && data[position + 1] == '\n'))
+                        return -1;
+                    if (position < length && data[position] == '\r')
+                        ++position;
+                }
+                else
+                    position = static_cast<int>(scan::FindFirstOf(data + position, data + length, delimiter, '\n') - data);
+
+                int end = position;
+                if (position < length && data[position] == '\n' && end > begin && data[end - 1] == '\r')
+                    --end;
+                onField(count, Span{ begin, end });
+                ++count;
+                if (position == length || data[position] == '\n')
+                {
+                    next = position == length ? length : position + 1;
+                    return count;
+                }
+                ++position;
+            }
+        }
+
+        /*
+        * Whether a result refers to characters or positions of the input it was parsed from.
+        */
+        template<typename T>
+        struct RefersToInput : std::false_type { };
+
+        template<>
+        struct RefersToInput<std::string_view> : std::true_type { };
+
+        template<>
+        struct RefersToInput<Span> : std::true_type { };
+
+        template<typename T1, typename T2>
+        struct RefersToInput<Pair<T1, T2>> : std::bool_constant<RefersToInput<T1>::value || RefersToInput<T2>::value> { };
+
+        template<typename... T>
+        struct RefersToInput<std::tuple<T...>> : std::bool_constant<(RefersToInput<T>::value || ...)> { };
+
+        template<typename T>
+        struct RefersToInput<std::vector<T>> : RefersToInput<T> { };
+
+        template<typename T>
+        struct RefersToInput<std::optional<T>> : RefersToInput<T> { };
+
+        /*
+        * The buffer that fields are copied into. A nested record parser finds it moved out and uses a buffer of its own.
+        */
+        inline thread_local std::string fieldBuffer;
+
+        /*
+        * Runs a parser on a copy of the field [begin, end) of the input, so the parser cannot read past the field,
+        * and requires it to consume the whole field. The buffer keeps its capacity, so only a field longer than any before it allocates.
+        * Views into the copy would dangle once the next field is parsed, so parsers returning them are rejected at compile time.
+        */
+        template<typename T>
+        inline bool ParseIsolated(const Parser<T>& parser, const std::string& string, int begin, int end, std::optional<T>& result)
+        {
+            static_assert(!RefersToInput<T>::value, "A field is parsed from a copy, so the result of its parser must not refer to the input.");
+            std::string field = std::move(fieldBuffer);
+            field.assign(string, begin, end - begin);
+            auto fieldResult = parser(field, 0);
+            bool success = fieldResult.Success() && fieldResult.GetPosition() == end - begin;
+            fieldBuffer = std::move(field);
+            if (!success)
+                return false;
+            result.emplace(std::move(fieldResult.GetResult()));
+            return true;
+        }
+    }
+
+    /*
+    * Returns a parser for a record of fields separated by a delimiter and terminated by a line break or the end of the input,
+    * which returns the text of each field. Quoted fields are returned with their quotes.
+    * When count is not negative, records with a different number of fields are rejected.
+    */
+    [[nodiscard]]
+    Parser<std::vector<std::string_view>> FieldSpans(char delimiter, int count = -1, char quote = '"');
+
+    /*
+    * Returns a parser for a record with one field per argument parser, separated by a delimiter and terminated by a line break
+    * or the end of the input. The fields are located in one scan, and each field parser then runs on a copy of its field,
+    * so it cannot read into the next one, and must consume the whole field including the quotes of a quoted field.
+    * Results must therefore not refer to the input, which is checked at compile time for views and spans; FieldSpans returns views.
+    */
+    template<typename... T>
+    [[nodiscard]]
+    inline Parser<std::tuple<T...>> Fields(char delimiter, char quote, const Parser<T>&... parsers)
+    {
+        constexpr int count = static_cast<int>(sizeof...(T));
+        std::tuple<Parser<T>...> p(parsers...);
+        return [=](const StringState& state, const std::string& string)
+        {
+            if (state.position >= static_cast<int>(string.length()))
+                return Fail<std::tuple<T...>>(state.position);
+            std::array<Span, count> spans;
+            int next;
+            auto store = [&](int index, const Span& span)
+            {
+                if (index < count)
+                    spans[index] = span;
+            };
+            if (detail::SplitRecord(string, state.position, delimiter, quote, store, next) != count)
+                return Fail<std::tuple<T...>>(state.position);
+
+            std::tuple<std::optional<T>...> results;
+            bool success = [&]<size_t... I>(std::index_sequence<I...>)
+            {
+                return (detail::ParseIsolated(std::get<I>(p), string, spans[I].begin, spans[I].end, std::get<I>(results)) && ...);
+            }(std::index_sequence_for<T...>());
+            if (!success)
+                return Fail<std::tuple<T...>>(state.position);
+
+            auto result = [&]<size_t... I>(std::index_sequence<I...>)
+            {
+                return std::tuple<T...>(std::move(*std::get<I>(results))...);
+            }(std::index_sequence_for<T...>());
+            return Success(next, std::move(result));
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef FIXED_WIDTH_H
+#define FIXED_WIDTH_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <tuple>
+#include <array>
+#include <optional>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include "Parser.h"
+#include "Fields.h"
+
+namespace prs
+{
+    /*
+    * A field of a fixed-width record: the number of characters it occupies and the parser for its contents.
+    */
+    template<typename T>
+    struct FixedField
+    {
+        int width;
+        Parser<T> parser;
+    };
+
+    namespace detail
+    {
+        /*
+        * Runs a parser on the slice [begin, end) of the input like ParseIsolated, ignoring spaces used as padding on either side of the value.
+        */
+        template<typename T>
+        inline bool ParseSlice(const Parser<T>& parser, const std::string& string, int begin, int end, std::optional<T>& result)
+        {
+            while (begin < end && string[begin] == ' ')
+                ++begin;
+            while (end > begin && string[end - 1] == ' ')
+                --end;
+            return ParseIsolated(parser, string, begin, end, result);
+        }
+    }
+
+    /*
+    * Returns a parser for a record made of fields of fixed widths, which runs each field parser on its own slice of the record.
+    * The slices are computed from the widths up front, so no delimiters are searched for.
+    * Each field parser runs on a copy of its slice, so it cannot read into the next field even when the values touch,
+    * but its result must not refer to the input, which is checked at compile time for views and spans. Throws std::invalid_argument if a width is negative.
+    * The line break after a record, if any, is not consumed.
+    */
+    template<typename... T>
+    [[nodiscard]]
+    inline Parser<std::tuple<T...>> FixedWidth(const FixedField<T>&... fields)
+    {
+        std::tuple<Parser<T>...> parsers(fields.parser...);
+        std::array<int, sizeof...(T) + 1> offsets{ 0 };
+        std::array<int, sizeof...(T)> widths{ fields.width... };
+        for (size_t i = 0; i < widths.size(); ++i)
+        {
+            if (widths[i] < 0)
+                throw std::invalid_argument("The width of a fixed-width field must not be negative.");
+            offsets[i + 1] = offsets[i] + widths[i];
+        }
+
+        return [=](const StringState& state, const std::string& string)
+        {
+            if (static_cast<int>(string.length()) - state.position < offsets.back())
+                return Fail<std::tuple<T...>>(state.position);
+
+            std::tuple<std::optional<T>...> results;
+            bool success = [&]<size_t... I>(std::index_sequence<I...>)
+            {
+                return (detail::ParseSlice(std::get<I>(parsers), string,
+                    state.position + offsets[I], state.position + offsets[I + 1], std::get<I>(results)) && ...);
+            }(std::index_sequence_for<T...>());
+            if (!success)
+                return Fail<std::tuple<T...>>(state.position);
+
+            auto result = [&]<size_t... I>(std::index_sequence<I...>)
+            {
+                return std::tuple<T...>(std::move(*std::get<I>(results))...);
+            }(std::index_sequence_for<T...>());
+            return Success(state.position + offsets.back(), std::move(result));
+        };
+    }
+
+    /*
+    * Returns a parser for consecutive records that each occupy stride characters, including any line break.
+    * Each record is first passed to the filter as raw text, and records it rejects are skipped without being parsed.
+    * Parsing stops at the end of the input or at the first accepted record that fails to parse.
+    * Throws std::invalid_argument if the stride is not positive.
+    */
+    template<typename T, typename F>
+    [[nodiscard]]
+    inline Parser<std::vector<T>> FixedWidthRecords(int stride, const F& filter, const Parser<T>& record)
+    {
+        if (stride <= 0)
+            throw std::invalid_argument("The stride of fixed-width records must be positive.");
+        return [=](const StringState& state, const std::string& string)
+        {
+            int length = static_cast<int>(string.length());
+            int position = state.position;
+            std::vector<T> results;
+            while (position < length)
+            {
+                int size = std::min(stride, length - position);
+                if (filter(std::string_view(string.data() + position, size)))
+                {
+                    auto result = record(string, position);
+                    if (!result.Success())
+                        break;
+                    results.push_back(std::move(result.GetResult()));
+                }
+                position += size;
+            }
+            return Success(position, std::move(results));
+        };
+    }
+}
+
+#endif
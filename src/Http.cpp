@@ -0,0 +1,255 @@
+#include "Http.h"
+#include "PerfectHash.h"
+#include "Scan.h"
+#include <array>
+
+namespace prs
+{
+    namespace
+    {
+        constexpr bool IsTokenCharacter(unsigned char c)
+        {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+                c == '!' || c == '#' || c == '$' || c == '%' || c == '&' || c == '\'' || c == '*' || c == '+' ||
+                c == '-' || c == '.' || c == '^' || c == '_' || c == '`' || c == '|' || c == '~';
+        }
+
+        constexpr std::array<bool, 256> tokenCharacters = []()
+        {
+            std::array<bool, 256> table{};
+            for (int c = 0; c < 256; ++c)
+                table[c] = IsTokenCharacter(static_cast<unsigned char>(c));
+            return table;
+        }();
+
+        bool IsToken(std::string_view text)
+        {
+            if (text.empty())
+                return false;
+            for (char c : text)
+                if (!tokenCharacters[static_cast<unsigned char>(c)])
+                    return false;
+            return true;
+        }
+
+        /*
+        * Returns the end of the line starting at position, which is the position of its CR,
+        * or -1 if there is no CRLF within limit characters or a line feed appears without a carriage return.
+        */
+        int LineEnd(const std::string& string, int position, int limit)
+        {
+            const char* data = string.data();
+            int length = static_cast<int>(string.length());
+            int end = position + limit < length ? position + limit + 1 : length;
+            int found = static_cast<int>(scan::FindFirstOf(data + position, data + end, '\r', '\n') - data);
+            if (found == end || found + 1 == length || data[found] != '\r' || data[found + 1] != '\n')
+                return -1;
+            return found;
+        }
+
+        /*
+        * Like LineEnd for a field line, which may only contain visible characters, spaces, tabs and obs-text.
+        * The line is scanned once for its end and for characters that are not allowed.
+        */
+        int FieldLineEnd(const std::string& string, int position, int limit)
+        {
+            const char* data = string.data();
+            int length = static_cast<int>(string.length());
+            const char* end = data + (position + limit < length ? position + limit + 1 : length);
+            const char* found = scan::FindFirstControl(data + position, end);
+            while (found != end && *found == '\t')
+                found = scan::FindFirstControl(found + 1, end);
+            if (found == end || found + 1 == data + length || found[0] != '\r' || found[1] != '\n')
+                return -1;
+            return static_cast<int>(found - data);
+        }
+
+        const PerfectHash& Methods()
+        {
+            static const PerfectHash methods({ "GET", "HEAD", "POST", "PUT", "DELETE", "CONNECT", "OPTIONS", "TRACE", "PATCH" });
+            return methods;
+        }
+
+        const PerfectHash& Headers()
+        {
+            static const PerfectHash headers({ "host", "content-length", "content-type", "transfer-encoding", "connection",
+                "accept", "accept-encoding", "accept-language", "user-agent", "cookie", "authorization", "cache-control",
+                "expect", "upgrade", "range", "referer", "origin", "if-modified-since", "if-none-match", "x-forwarded-for" }, true);
+            return headers;
+        }
+
+        /*
+        * Parses the field line starting at position, whose CR is at end and which FieldLineEnd has checked for control characters.
+        */
+        bool ParseField(const std::string& string, int position, int end, const PerfectHash& headers, HttpField& field)
+        {
+            const char* data = string.data();
+            int colon = position;
+            while (colon < end && tokenCharacters[static_cast<unsigned char>(data[colon])])
+                ++colon;
+            std::string_view name(data + position, colon - position);
+            if (colon == end || colon == position || data[colon] != ':')
+                return false;
+            int begin = colon + 1;
+            while (begin < end && (data[begin] == ' ' || data[begin] == '\t'))
+                ++begin;
+            int last = end;
+            while (last > begin && (data[last - 1] == ' ' || data[last - 1] == '\t'))
+                --last;
+            int index = headers.Find(name);
+            field.header = index < 0 ? HttpHeader::Other : static_cast<HttpHeader>(index);
+            field.name = name;
+            field.value = std::string_view(data + begin, last - begin);
+            return true;
+        }
+
+        bool ParseRequestLine(const std::string& string, int position, int end, const PerfectHash& methods, HttpRequest& request)
+        {
+            const char* data = string.data();
+            int space = position;
+            while (space < end && data[space] != ' ')
+                ++space;
+            std::string_view method(data + position, space - position);
+            if (space == end || !IsToken(method))
+                return false;
+            int targetBegin = space + 1;
+            int targetEnd = targetBegin;
+            while (targetEnd < end && data[targetEnd] > ' ' && data[targetEnd] < 0x7F)
+                ++targetEnd;
+            if (targetEnd == targetBegin || targetEnd == end || data[targetEnd] != ' ')
+                return false;
+            std::string_view version(data + targetEnd + 1, end - targetEnd - 1);
+            if (version.length() != 8 || version.substr(0, 5) != "HTTP/" || version[6] != '.' ||
+                version[5] < '0' || version[5] > '9' || version[7] < '0' || version[7] > '9')
+                return false;
+            int index = methods.Find(method);
+            request.method = index < 0 ? HttpMethod::Other : static_cast<HttpMethod>(index);
+            request.methodName = method;
+            request.target = std::string_view(data + targetBegin, targetEnd - targetBegin);
+            request.majorVersion = version[5] - '0';
+            request.minorVersion = version[7] - '0';
+            return true;
+        }
+
+        /*
+        * Compares text with a lowercase word, ignoring the case of the letters of text.
+        */
+        bool EqualsLowercase(std::string_view text, std::string_view lowercase)
+        {
+            if (text.length() != lowercase.length())
+                return false;
+            for (size_t i = 0; i < text.length(); ++i)
+            {
+                char c = text[i] >= 'A' && text[i] <= 'Z' ? static_cast<char>(text[i] + ('a' - 'A')) : text[i];
+                if (c != lowercase[i])
+                    return false;
+            }
+            return true;
+        }
+
+        /*
+        * Sets the content length and transfer coding of a request from its fields,
+        * and returns false when they leave the length of the body ambiguous.
+        */
+        bool ValidateFraming(HttpRequest& request)
+        {
+            const HttpField* transferEncoding = nullptr;
+            for (const HttpField& field : request.fields)
+            {
+                if (field.header == HttpHeader::ContentLength)
+                {
+                    std::string_view value = field.value;
+                    if (value.empty() || value.length() > 18)
+                        return false;
+                    std::int64_t length = 0;
+                    for (char c : value)
+                    {
+                        if (c < '0' || c > '9')
+                            return false;
+                        length = length * 10 + (c - '0');
+                    }
+                    if (request.contentLength >= 0 && request.contentLength != length)
+                        return false;
+                    request.contentLength = length;
+                }
+                else if (field.header == HttpHeader::TransferEncoding)
+                    transferEncoding = &field;
+            }
+            if (transferEncoding == nullptr)
+                return true;
+            if (request.contentLength >= 0)
+                return false;
+            std::string_view last = transferEncoding->value;
+            size_t comma = last.rfind(',');
+            if (comma != std::string_view::npos)
+                last.remove_prefix(comma + 1);
+            while (!last.empty() && (last.front() == ' ' || last.front() == '\t'))
+                last.remove_prefix(1);
+            if (!EqualsLowercase(last, "chunked"))
+                return false;
+            request.chunked = true;
+            return true;
+        }
+    }
+
+    const HttpField* HttpRequest::Find(HttpHeader header) const
+    {
+        for (const HttpField& field : fields)
+            if (field.header == header)
+                return &field;
+        return nullptr;
+    }
+
+    Parser<HttpField> HttpFieldLine(const HttpLimits& limits)
+    {
+        int maximum = limits.maximumFieldLine;
+        const PerfectHash* headers = &Headers();
+        return [maximum, headers](const StringState& state, const std::string& string)
+        {
+            if (state.position >= static_cast<int>(string.length()))
+                return Fail<HttpField>(state.position);
+            int end = FieldLineEnd(string, state.position, maximum);
+            HttpField field;
+            if (end < 0 || !ParseField(string, state.position, end, *headers, field))
+                return Fail<HttpField>(state.position);
+            return Success(end + 2, field);
+        };
+    }
+
+    Parser<HttpRequest> HttpRequestHead(const HttpLimits& limits)
+    {
+        const PerfectHash* methods = &Methods();
+        const PerfectHash* headers = &Headers();
+        return [limits, methods, headers](const StringState& state, const std::string& string)
+        {
+            if (state.position >= static_cast<int>(string.length()))
+                return Fail<HttpRequest>(state.position);
+            int headEnd = state.position + limits.maximumHead;
+            int end = LineEnd(string, state.position, limits.maximumRequestLine);
+            HttpRequest request;
+            if (end < 0 || end + 2 > headEnd || !ParseRequestLine(string, state.position, end, *methods, request))
+                return Fail<HttpRequest>(state.position);
+
+            request.fields.reserve(16);
+            int position = end + 2;
+            while (true)
+            {
+                end = FieldLineEnd(string, position, limits.maximumFieldLine);
+                if (end < 0 || end + 2 > headEnd)
+                    return Fail<HttpRequest>(state.position);
+                if (end == position)
+                {
+                    if (!ValidateFraming(request))
+                        return Fail<HttpRequest>(state.position);
+                    return Success(end + 2, std::move(request));
+                }
+                if (static_cast<int>(request.fields.size()) == limits.maximumFields)
+                    return Fail<HttpRequest>(state.position);
+                HttpField& field = request.fields.emplace_back();
+                if (!ParseField(string, position, end, *headers, field))
+                    return Fail<HttpRequest>(state.position);
+                position = end + 2;
+            }
+        };
+    }
+}
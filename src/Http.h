@@ -0,0 +1,122 @@
+#ifndef HTTP_H
+#define HTTP_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include "Parser.h"
+
+/*
+*
+* Parsers for the head of an HTTP/1.1 request as defined by RFC 9112: the request line and the header fields up to the empty line.
+* Results are views into the input. Line breaks must be CRLF, and obsolete line folding is rejected.
+*
+*/
+
+namespace prs
+{
+    enum class HttpMethod
+    {
+        Get,
+        Head,
+        Post,
+        Put,
+        Delete,
+        Connect,
+        Options,
+        Trace,
+        Patch,
+        Other
+    };
+
+    /*
+    * Header names that are recognized while parsing, so they can be looked up without comparing strings.
+    */
+    enum class HttpHeader
+    {
+        Host,
+        ContentLength,
+        ContentType,
+        TransferEncoding,
+        Connection,
+        Accept,
+        AcceptEncoding,
+        AcceptLanguage,
+        UserAgent,
+        Cookie,
+        Authorization,
+        CacheControl,
+        Expect,
+        Upgrade,
+        Range,
+        Referer,
+        Origin,
+        IfModifiedSince,
+        IfNoneMatch,
+        XForwardedFor,
+        Other
+    };
+
+    struct HttpField
+    {
+        HttpHeader header;
+        std::string_view name;
+        /*
+        * The value without the whitespace that surrounds it.
+        */
+        std::string_view value;
+    };
+
+    struct HttpRequest
+    {
+        HttpMethod method;
+        std::string_view methodName;
+        std::string_view target;
+        int majorVersion;
+        int minorVersion;
+        std::vector<HttpField> fields;
+        /*
+        * The length of the body given by Content-Length, or -1 if there is no Content-Length field.
+        */
+        std::int64_t contentLength = -1;
+        /*
+        * Whether the body uses the chunked transfer coding.
+        */
+        bool chunked = false;
+
+        /*
+        * Returns the first field with a recognized name, or nullptr if there is none.
+        */
+        const HttpField* Find(HttpHeader header) const;
+    };
+
+    /*
+    * The limits beyond which a request head is rejected.
+    */
+    struct HttpLimits
+    {
+        int maximumRequestLine = 8192;
+        int maximumFieldLine = 8192;
+        int maximumFields = 100;
+        int maximumHead = 65536;
+    };
+
+    /*
+    * Returns a parser for one header field line including its CRLF.
+    */
+    [[nodiscard]]
+    Parser<HttpField> HttpFieldLine(const HttpLimits& limits = HttpLimits());
+
+    /*
+    * Returns a parser for a request line, the header fields and the empty line that ends them.
+    * The parser stops after the empty line, where the body starts.
+    * To prevent request smuggling, the message framing is validated as described in RFC 9112, section 6.3:
+    * a request is rejected when it has both Transfer-Encoding and Content-Length, when Content-Length is not a number
+    * or is repeated with different values, or when chunked is not the final transfer coding.
+    */
+    [[nodiscard]]
+    Parser<HttpRequest> HttpRequestHead(const HttpLimits& limits = HttpLimits());
+}
+
+#endif
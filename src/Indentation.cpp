@@ -0,0 +1,78 @@
+#include "Indentation.h"
+
+namespace prs
+{
+    namespace
+    {
+        bool IsIndentation(char c)
+        {
+            return c == ' ' || c == '\t';
+        }
+    }
+
+    Indentation::Scope::Scope(Indentation& indentation, int level)
+        : indentation(indentation)
+    {
+        indentation.levels.push_back(level);
+    }
+
+    Indentation::Scope::~Scope()
+    {
+        indentation.levels.pop_back();
+    }
+
+    int Indentation::Current() const
+    {
+        if (levels.empty())
+            return -1;
+        return levels.back();
+    }
+
+    int Indentation::Width(const std::string& string, int lineStart)
+    {
+        auto cached = widths.find(lineStart);
+        if (cached != widths.end())
+            return cached->second;
+        int position = lineStart;
+        while (position < static_cast<int>(string.length()) && IsIndentation(string[position]))
+            ++position;
+        int width = position - lineStart;
+        widths.emplace(lineStart, width);
+        return width;
+    }
+
+    void Indentation::Enter()
+    {
+        if (levels.empty())
+            widths.clear();
+    }
+
+    namespace detail
+    {
+        int IndentedLineStart(const std::string& string, int position)
+        {
+            while (position > 0 && IsIndentation(string[position - 1]))
+                --position;
+            if (position == 0 || string[position - 1] == '\n')
+                return position;
+            return -1;
+        }
+
+        int SkipBlankLines(const std::string& string, int lineStart)
+        {
+            int length = static_cast<int>(string.length());
+            int position = lineStart;
+            while (position < length)
+            {
+                char c = string[position];
+                if (c == '\n')
+                    lineStart = ++position;
+                else if (IsIndentation(c) || c == '\r')
+                    ++position;
+                else
+                    return lineStart;
+            }
+            return length;
+        }
+    }
+}
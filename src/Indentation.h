@@ -0,0 +1,175 @@
+#ifndef INDENTATION_H
+#define INDENTATION_H
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstring>
+#include <unordered_map>
+#include "Parser.h"
+
+/*
+*
+* Combinators for indentation-sensitive grammars such as YAML-like or Python-like configuration files.
+* Spaces and tabs both count as one column of indentation.
+*
+*/
+
+namespace prs
+{
+    /*
+    * The indentation stack shared by the Block and Indented parsers of a grammar.
+    * The indentation of a line is measured once and cached by the position of the line start,
+    * so closing several nested blocks on the same line does not rescan its leading whitespace.
+    * The cache is cleared whenever an outermost block is entered, which makes it safe to reuse an instance for several inputs,
+    * but not for parsing several inputs at the same time.
+    */
+    class Indentation
+    {
+    private:
+        std::vector<int> levels;
+        std::unordered_map<int, int> widths;
+    public:
+        /*
+        * Pushes an indentation level for the lifetime of the object.
+        */
+        class Scope
+        {
+        private:
+            Indentation& indentation;
+        public:
+            Scope(Indentation& indentation, int level);
+            ~Scope();
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+        };
+
+        /*
+        * Returns the indentation of the innermost enclosing block, or -1 outside of any block.
+        */
+        int Current() const;
+
+        /*
+        * Returns the number of leading spaces and tabs of the line starting at lineStart.
+        */
+        int Width(const std::string& string, int lineStart);
+
+        /*
+        * Clears the cached line widths when no block is being parsed.
+        */
+        void Enter();
+    };
+
+    namespace detail
+    {
+        /*
+        * Returns the start of the line containing position if only indentation precedes position on that line, otherwise -1.
+        */
+        int IndentedLineStart(const std::string& string, int position);
+
+        /*
+        * Returns the start of the first line at or after lineStart that contains more than indentation.
+        * Returns the length of the input when only blank lines remain.
+        */
+        int SkipBlankLines(const std::string& string, int lineStart);
+    }
+
+    /*
+    * Returns a parser for one or more items that all start on their own line at the same indentation,
+    * which must be deeper than that of the enclosing block.
+    * Each item is run after the indentation of its line and should consume the line break that ends it.
+    * The block ends at the first line that is indented differently or that the item parser does not accept.
+    */
+    template<typename T>
+    [[nodiscard]]
+    inline Parser<std::vector<T>> Block(const std::shared_ptr<Indentation>& indentation, const Parser<T>& item)
+    {
+        return [=](const StringState& state, const std::string& string)
+        {
+            indentation->Enter();
+            int lineStart = detail::IndentedLineStart(string, state.position);
+            if (lineStart < 0)
+                return Fail<std::vector<T>>(state.position);
+            lineStart = detail::SkipBlankLines(string, lineStart);
+            if (lineStart == static_cast<int>(string.length()))
+                return Fail<std::vector<T>>(state.position);
+            int level = indentation->Width(string, lineStart);
+            if (level <= indentation->Current() || lineStart + level < state.position)
+                return Fail<std::vector<T>>(state.position);
+
+            Indentation::Scope scope(*indentation, level);
+            std::vector<T> results;
+            int position = state.position;
+            while (true)
+            {
+                auto result = item(string, lineStart + level);
+                if (!result.Success())
+                    break;
+                results.push_back(std::move(result.GetResult()));
+                position = result.GetPosition();
+
+                int next = detail::IndentedLineStart(string, position);
+                if (next <= lineStart)
+                    break;
+                next = detail::SkipBlankLines(string, next);
+                if (next == static_cast<int>(string.length()) || indentation->Width(string, next) != level)
+                    break;
+                lineStart = next;
+            }
+            if (results.empty())
+                return Fail<std::vector<T>>(state.position);
+            return Success(position, std::move(results));
+        };
+    }
+
+    /*
+    * Returns a parser that runs the argument on the current line after its indentation,
+    * provided that the line is indented deeper than the enclosing block.
+    * Blocks nested inside the argument must be indented deeper than this line.
+    */
+    template<typename T>
+    [[nodiscard]]
+    inline Parser<T> Indented(const std::shared_ptr<Indentation>& indentation, const Parser<T>& parser)
+    {
+        return [=](const StringState& state, const std::string& string)
+        {
+            indentation->Enter();
+            int lineStart = detail::IndentedLineStart(string, state.position);
+            if (lineStart < 0)
+                return Fail<T>(state.position);
+            lineStart = detail::SkipBlankLines(string, lineStart);
+            if (lineStart == static_cast<int>(string.length()))
+                return Fail<T>(state.position);
+            int level = indentation->Width(string, lineStart);
+            if (level <= indentation->Current() || lineStart + level < state.position)
+                return Fail<T>(state.position);
+
+            Indentation::Scope scope(*indentation, level);
+            auto result = parser(string, lineStart + level);
+            if (result.Success())
+                return result;
+            return Fail<T>(state.position);
+        };
+    }
+
+    /*
+    * Returns a parser that fails if the argument consumes a line break.
+    */
+    template<typename T>
+    [[nodiscard]]
+    inline Parser<T> SameLine(const Parser<T>& parser)
+    {
+        return [=](const StringState& state, const std::string& string)
+        {
+            auto result = parser(string, state.position);
+            if (!result.Success())
+                return Fail<T>(state.position);
+            size_t count = result.GetPosition() - state.position;
+            if (std::memchr(string.data() + state.position, '\n', count) != nullptr)
+                return Fail<T>(state.position);
+            return result;
+        };
+    }
+}
+
+#endif
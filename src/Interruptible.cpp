@@ -0,0 +1,279 @@
+#include "Interruptible.h"
+#include <exception>
+#include <utility>
+#include <algorithm>
+#include <limits>
+#include <new>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <ucontext.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace prs
+{
+    namespace detail
+    {
+        namespace
+        {
+            constexpr std::int64_t unlimited = std::numeric_limits<std::int64_t>::max();
+
+            /*
+            * The stack of a job, as large as the default stack of a thread.
+            */
+            constexpr size_t stackSize = 8 << 20;
+
+            /*
+            * The state that checkpoints read besides the step budget. A job has its own, which is swapped
+            * with the calling thread's whenever control passes between them.
+            */
+            struct StepState
+            {
+                Slicer* slicer = nullptr;
+                const std::atomic<size_t>* cancellationBound = nullptr;
+                size_t cancellationIndex = 0;
+                std::int64_t cancellationInterval = unlimited;
+
+                /*
+                * The steps left in the current slice beyond the step budget, which is at most the cancellation interval.
+                */
+                std::int64_t reserve = unlimited;
+            };
+
+            thread_local StepState current;
+
+            /*
+            * Starts a new step budget of at most one cancellation interval, taken from the reserve.
+            */
+            void Refill()
+            {
+                stepBudget = std::min(current.cancellationInterval, current.reserve);
+                if (current.reserve != unlimited)
+                    current.reserve -= stepBudget;
+            }
+
+            /*
+            * Returns the budget and reserve to the pool of steps left in the slice, and starts a new budget from them.
+            */
+            void Rebalance()
+            {
+                if (current.reserve != unlimited)
+                    current.reserve += std::max<std::int64_t>(stepBudget, 0);
+                Refill();
+            }
+        }
+
+        constinit thread_local std::int64_t stepBudget = unlimited;
+
+        void OnBudgetSpent()
+        {
+            if (current.cancellationBound != nullptr && current.cancellationBound->load(std::memory_order_relaxed) < current.cancellationIndex)
+                throw ParseCancelled();
+            if (current.reserve == 0 && current.slicer != nullptr)
+                current.slicer->Yield();
+            Refill();
+        }
+
+        CancellationScope::CancellationScope(const std::atomic<size_t>& bound, size_t index, std::int64_t interval)
+            : previousBound(current.cancellationBound), previousIndex(current.cancellationIndex),
+            previousInterval(current.cancellationInterval)
+        {
+            current.cancellationBound = &bound;
+            current.cancellationIndex = index;
+            current.cancellationInterval = interval;
+            Rebalance();
+        }
+
+        CancellationScope::~CancellationScope()
+        {
+            current.cancellationBound = previousBound;
+            current.cancellationIndex = previousIndex;
+            current.cancellationInterval = previousInterval;
+            Rebalance();
+        }
+
+        struct Slicer::State
+        {
+            std::function<void()> job;
+            std::int64_t stepsPerSlice;
+            bool started = false;
+            bool finished = false;
+            bool cancelled = false;
+            std::exception_ptr exception;
+
+            /*
+            * The step state and budget of whichever side is not running: the job's while the caller runs, and the other way round.
+            */
+            StepState suspended;
+            std::int64_t suspendedBudget;
+#ifdef _WIN32
+            void* caller = nullptr;
+            void* worker = nullptr;
+#else
+            ucontext_t caller;
+            ucontext_t worker;
+            void* stack = nullptr;
+            size_t mappedSize = 0;
+
+            /*
+            * makecontext only passes int arguments, so the job being started is handed over here.
+            */
+            static thread_local State* starting;
+#endif
+            /*
+            * Passes control from the caller to the job, and returns when the job yields or finishes.
+            */
+            void SwitchToJob();
+
+            /*
+            * Passes control from the job back to the caller.
+            */
+            void SwitchToCaller();
+
+            /*
+            * Swaps the step state of the running side with the suspended one.
+            */
+            void SwapStepState()
+            {
+                std::swap(current, suspended);
+                std::swap(stepBudget, suspendedBudget);
+            }
+
+            /*
+            * Runs the job to completion on its own stack and passes control back for good.
+            */
+            void Run()
+            {
+                try
+                {
+                    job();
+                }
+                catch (const ParseCancelled&)
+                {
+                }
+                catch (...)
+                {
+                    exception = std::current_exception();
+                }
+                finished = true;
+                SwitchToCaller();
+            }
+
+#ifdef _WIN32
+            static void CALLBACK Start(void* state)
+            {
+                static_cast<State*>(state)->Run();
+            }
+#else
+            static void Start()
+            {
+                starting->Run();
+            }
+#endif
+        };
+
+#ifdef _WIN32
+        void Slicer::State::SwitchToJob()
+        {
+            if (worker == nullptr)
+            {
+                worker = CreateFiber(stackSize, Start, this);
+                if (worker == nullptr)
+                    throw std::bad_alloc();
+            }
+            bool converted = !IsThreadAFiber();
+            if (converted)
+                ConvertThreadToFiber(nullptr);
+            caller = GetCurrentFiber();
+            SwitchToFiber(worker);
+            if (converted)
+                ConvertFiberToThread();
+        }
+
+        void Slicer::State::SwitchToCaller()
+        {
+            SwitchToFiber(caller);
+        }
+#else
+        thread_local Slicer::State* Slicer::State::starting = nullptr;
+
+        void Slicer::State::SwitchToJob()
+        {
+            if (stack == nullptr)
+            {
+                size_t guardSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+                mappedSize = stackSize + guardSize;
+                void* mapped = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (mapped == MAP_FAILED)
+                    throw std::bad_alloc();
+                stack = mapped;
+                mprotect(stack, guardSize, PROT_NONE);
+                getcontext(&worker);
+                worker.uc_stack.ss_sp = static_cast<char*>(stack) + guardSize;
+                worker.uc_stack.ss_size = stackSize;
+                worker.uc_link = nullptr;
+                makecontext(&worker, Start, 0);
+                starting = this;
+            }
+            swapcontext(&caller, &worker);
+        }
+
+        void Slicer::State::SwitchToCaller()
+        {
+            swapcontext(&worker, &caller);
+        }
+#endif
+
+        Slicer::Slicer(std::function<void()> job, std::int64_t stepsPerSlice)
+            : state(std::make_unique<State>())
+        {
+            state->job = std::move(job);
+            state->stepsPerSlice = stepsPerSlice > 0 ? stepsPerSlice : 1;
+            state->suspended.slicer = this;
+            state->suspended.reserve = 0;
+            state->suspendedBudget = state->stepsPerSlice;
+        }
+
+        Slicer::~Slicer()
+        {
+            if (state->started && !state->finished)
+            {
+                state->cancelled = true;
+                state->SwapStepState();
+                state->SwitchToJob();
+                state->SwapStepState();
+            }
+#ifdef _WIN32
+            if (state->worker != nullptr)
+                DeleteFiber(state->worker);
+#else
+            if (state->stack != nullptr)
+                munmap(state->stack, state->mappedSize);
+#endif
+        }
+
+        bool Slicer::Resume()
+        {
+            if (state->finished)
+                return true;
+            state->started = true;
+            state->SwapStepState();
+            state->SwitchToJob();
+            state->SwapStepState();
+            if (state->exception)
+                std::rethrow_exception(std::exchange(state->exception, nullptr));
+            return state->finished;
+        }
+
+        void Slicer::Yield()
+        {
+            state->SwitchToCaller();
+            if (state->cancelled)
+                throw ParseCancelled();
+            current.reserve = state->stepsPerSlice;
+        }
+    }
+}
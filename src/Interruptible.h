@@ -0,0 +1,140 @@
+#ifndef INTERRUPTIBLE_H
+#define INTERRUPTIBLE_H
+
+#include <string>
+#include <memory>
+#include <optional>
+#include <functional>
+#include <cstdint>
+#include <atomic>
+#include "Parser.h"
+
+/*
+*
+* Support for parsing large inputs in slices, so a parse on an event loop can hand control back between slices.
+* The grammar marks the points where it may be suspended with Checkpoint. An InterruptibleParse runs the parse on
+* the thread that calls Resume, on a stack of its own, and switches back to Resume at the checkpoint where the step budget
+* of a slice is spent. No thread is started, so the parse must be resumed on the thread that first resumed it.
+*
+*/
+
+namespace prs
+{
+    namespace detail
+    {
+        /*
+        * The number of checkpoints the current thread may still pass before it has to yield.
+        */
+        extern constinit thread_local std::int64_t stepBudget;
+
+        /*
+        * Called when the step budget is spent. Abandons the parse when it has been cancelled,
+        * suspends it when it runs as an InterruptibleParse and its slice is over, and starts a new budget otherwise.
+        */
+        void OnBudgetSpent();
+
+        /*
+        * Thrown at a checkpoint to unwind a parse that has been cancelled.
+        */
+        struct ParseCancelled { };
+
+        /*
+        * Makes the checkpoints passed on the current thread abandon the parse once bound drops below index,
+        * checking every interval steps, for the lifetime of the object. The steps spent within the scope count towards
+        * the slice of an enclosing InterruptibleParse.
+        */
+        class CancellationScope
+        {
+        private:
+            const std::atomic<size_t>* previousBound;
+            size_t previousIndex;
+            std::int64_t previousInterval;
+        public:
+            CancellationScope(const std::atomic<size_t>& bound, size_t index, std::int64_t interval);
+            ~CancellationScope();
+
+            CancellationScope(const CancellationScope&) = delete;
+            CancellationScope& operator=(const CancellationScope&) = delete;
+        };
+
+        /*
+        * Runs a job on a stack of its own on the calling thread, one slice at a time.
+        */
+        class Slicer
+        {
+        private:
+            struct State;
+            std::unique_ptr<State> state;
+        public:
+            Slicer(std::function<void()> job, std::int64_t stepsPerSlice);
+            ~Slicer();
+
+            Slicer(const Slicer&) = delete;
+            Slicer& operator=(const Slicer&) = delete;
+
+            /*
+            * Runs the job until it yields or finishes, and returns whether it has finished.
+            * Exceptions thrown by the job are rethrown here.
+            */
+            bool Resume();
+
+            /*
+            * Called from the job to hand control back to Resume.
+            */
+            void Yield();
+        };
+    }
+
+    /*
+    * Returns a parser that counts as one step of an interruptible or cancellable parse before running its argument.
+    * Outside of an interruptible parse the cost is one decrement and branch.
+    */
+    template<typename T>
+    [[nodiscard]]
+    inline Parser<T> Checkpoint(const Parser<T>& parser)
+    {
+        return [=](const StringState& state, const std::string& string)
+        {
+            if (--detail::stepBudget <= 0)
+                detail::OnBudgetSpent();
+            return parser(string, state.position);
+        };
+    }
+
+    /*
+    * A parse that can be run in slices of a fixed number of checkpoints.
+    * The input must outlive the parse. Destroying an unfinished parse cancels it.
+    */
+    template<typename T>
+    class InterruptibleParse
+    {
+    private:
+        std::shared_ptr<std::optional<ParseResult<T>>> result;
+        detail::Slicer slicer;
+    public:
+        InterruptibleParse(const Parser<T>& parser, const std::string& string, std::int64_t stepsPerSlice)
+            : result(std::make_shared<std::optional<ParseResult<T>>>()),
+            slicer([parser, input = &string, output = result]()
+                {
+                    output->emplace(parser(*input));
+                }, stepsPerSlice) { }
+
+        /*
+        * Parses until the step budget of a slice is spent or the parse finishes, and returns whether it has finished.
+        */
+        bool Resume()
+        {
+            return slicer.Resume();
+        }
+
+        /*
+        * Returns the result of a finished parse.
+        */
+        ParseResult<T>& GetResult()
+        {
+            return result->value();
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,262 @@
+#include "Json.h"
+#include "Strings.h"
+#include <charconv>
+#include <cstring>
+#include <cstdlib>
+#include <type_traits>
+
+namespace prs
+{
+    namespace detail
+    {
+        struct JsonScratch
+        {
+            std::vector<JsonValue> elements;
+            std::vector<JsonMember> members;
+            int depth = 0;
+        };
+    }
+
+    namespace
+    {
+        bool IsDigit(char c)
+        {
+            return c >= '0' && c <= '9';
+        }
+
+        Parser<Void> jsonWhitespace = [](const StringState& state, const std::string& string)
+        {
+            int position = state.position;
+            int length = static_cast<int>(string.length());
+            while (position < length)
+            {
+                char c = string[position];
+                if (c == ' ' || c == '\n' || c == '\r' || c == '\t')
+                    ++position;
+                else
+                    break;
+            }
+            return Success(position, Void());
+        };
+
+        Parser<double> jsonNumber = [](const StringState& state, const std::string& string)
+        {
+            const char* data = string.data();
+            int length = static_cast<int>(string.length());
+            int position = state.position;
+            if (position < length && data[position] == '-')
+                ++position;
+            if (position < length && data[position] == '0')
+                ++position;
+            else if (position < length && IsDigit(data[position]))
+                while (position < length && IsDigit(data[position]))
+                    ++position;
+            else
+                return Fail<double>(state.position);
+            if (position < length && data[position] == '.')
+            {
+                int digits = ++position;
+                while (position < length && IsDigit(data[position]))
+                    ++position;
+                if (position == digits)
+                    return Fail<double>(state.position);
+            }
+            if (position < length && (data[position] == 'e' || data[position] == 'E'))
+            {
+                ++position;
+                if (position < length && (data[position] == '+' || data[position] == '-'))
+                    ++position;
+                int digits = position;
+                while (position < length && IsDigit(data[position]))
+                    ++position;
+                if (position == digits)
+                    return Fail<double>(state.position);
+            }
+            double value;
+            auto [end, error] = std::from_chars(data + state.position, data + position, value);
+            if (error == std::errc::result_out_of_range)
+            {
+                // from_chars leaves value unwritten here, while strtod rounds to infinity or zero.
+                value = std::strtod(std::string(data + state.position, data + position).c_str(), nullptr);
+            }
+            else if (error != std::errc() || end != data + position)
+                return Fail<double>(state.position);
+            return Success(position, value);
+        };
+
+        /*
+        * RFC 8259 requires characters below U+0020 to be escaped in strings.
+        */
+        bool ContainsControlCharacter(const char* begin, const char* end)
+        {
+            for (const char* p = begin; p < end; ++p)
+                if (static_cast<unsigned char>(*p) < 0x20)
+                    return true;
+            return false;
+        }
+
+        Parser<JsonValue> Literal(const std::string& text, JsonValue value)
+        {
+            return [text, value](const StringState& state, const std::string& string)
+            {
+                if (string.compare(state.position, text.length(), text) != 0)
+                    return Fail<JsonValue>(state.position);
+                return Success(state.position + static_cast<int>(text.length()), value);
+            };
+        }
+
+        /*
+        * Returns a parser for an array or an object, whose body pushes the elements or members on the given stack.
+        * The pushed entries are copied to the arena once the body succeeds and removed from the stack in any case.
+        */
+        template<typename T>
+        Parser<JsonValue> Container(const std::shared_ptr<detail::JsonScratch>& scratch, std::vector<T> detail::JsonScratch::* stack,
+            Arena* arena, const Parser<Void>& body)
+        {
+            return [=](const StringState& state, const std::string& string)
+            {
+                if (scratch->depth >= JsonParser::maximumDepth)
+                    return Fail<JsonValue>(state.position);
+                std::vector<T>& entries = (*scratch).*stack;
+                size_t base = entries.size();
+                ++scratch->depth;
+                auto result = body(string, state.position);
+                --scratch->depth;
+                if (!result.Success())
+                {
+                    entries.resize(base);
+                    return Fail<JsonValue>(state.position);
+                }
+
+                JsonValue value;
+                value.size = entries.size() - base;
+                T* copy = nullptr;
+                if (value.size > 0)
+                {
+                    copy = static_cast<T*>(arena->Allocate(value.size * sizeof(T), alignof(T)));
+                    std::memcpy(static_cast<void*>(copy), entries.data() + base, value.size * sizeof(T));
+                }
+                entries.resize(base);
+                if constexpr (std::is_same_v<T, JsonMember>)
+                {
+                    value.type = JsonType::Object;
+                    value.members = copy;
+                }
+                else
+                {
+                    value.type = JsonType::Array;
+                    value.elements = copy;
+                }
+                return Success(result.GetPosition(), value);
+            };
+        }
+    }
+
+    const JsonValue* JsonValue::Find(std::string_view name) const
+    {
+        for (const JsonMember& member : Object())
+            if (member.name == name)
+                return &member.value;
+        return nullptr;
+    }
+
+    JsonParser::JsonParser(std::shared_ptr<Arena> arena)
+        : JsonParser(std::move(arena), CreateParserForwardedToRef<JsonValue>()) { }
+
+    JsonParser::JsonParser(std::shared_ptr<Arena> arena, std::pair<Parser<JsonValue>, std::shared_ptr<Parser<JsonValue>>> forward)
+        : arena(arena),
+        scratch(std::make_shared<detail::JsonScratch>()),
+        valueReference(forward.second),
+        value(jsonWhitespace >> forward.first >> jsonWhitespace)
+    {
+        auto s = scratch;
+        Arena* a = arena.get();
+        Parser<Void> comma = ~Char(',');
+
+        Parser<std::string_view> unescaped = QuotedString(arena);
+        Parser<std::string_view> quoted = [unescaped](const StringState& state, const std::string& text)
+        {
+            auto result = unescaped(text, state.position);
+            if (!result.Success() || ContainsControlCharacter(text.data() + state.position + 1, text.data() + result.GetPosition() - 1))
+                return Fail<std::string_view>(state.position);
+            return result;
+        };
+        Parser<JsonValue> string = quoted | [](std::string_view text)
+        {
+            JsonValue result;
+            result.type = JsonType::String;
+            result.characters = text.data();
+            result.size = text.size();
+            return result;
+        };
+
+        Parser<JsonValue> number = jsonNumber | [](double n)
+        {
+            JsonValue result;
+            result.type = JsonType::Number;
+            result.number = n;
+            return result;
+        };
+
+        JsonValue trueValue, falseValue, nullValue;
+        trueValue.type = falseValue.type = JsonType::Boolean;
+        trueValue.boolean = true;
+        falseValue.boolean = false;
+
+        auto count = [](int count, Void) { return count + 1; };
+
+        Parser<Void> pushElement = value | [s](const JsonValue& element)
+        {
+            s->elements.push_back(element);
+            return Void();
+        };
+        Parser<JsonValue> array = Container(s, &detail::JsonScratch::elements, a,
+            ~Char('[') >> jsonWhitespace >> ~SepBy(pushElement, comma, 0, count) >> ~Char(']'));
+
+        Parser<Void> pushMember = jsonWhitespace >> quoted >> jsonWhitespace >> ~Char(':') >> value |
+            [s](const Pair<std::string_view, JsonValue>& member)
+            {
+                s->members.push_back(JsonMember{ member.first, member.second });
+                return Void();
+            };
+        Parser<JsonValue> object = Container(s, &detail::JsonScratch::members, a,
+            ~Char('{') >> jsonWhitespace >> ~SepBy(pushMember, comma, 0, count) >> jsonWhitespace >> ~Char('}'));
+
+        Parser<JsonValue> trueLiteral = Literal("true", trueValue);
+        Parser<JsonValue> falseLiteral = Literal("false", falseValue);
+        Parser<JsonValue> nullLiteral = Literal("null", nullValue);
+
+        *valueReference = [=](const StringState& state, const std::string& text)
+        {
+            if (state.position >= static_cast<int>(text.length()))
+                return Fail<JsonValue>(state.position);
+            switch (text[state.position])
+            {
+            case '{': return object(text, state.position);
+            case '[': return array(text, state.position);
+            case '"': return string(text, state.position);
+            case 't': return trueLiteral(text, state.position);
+            case 'f': return falseLiteral(text, state.position);
+            case 'n': return nullLiteral(text, state.position);
+            default: return number(text, state.position);
+            }
+        };
+    }
+
+    JsonParser::~JsonParser()
+    {
+        *valueReference = [](const StringState& state, const std::string&)
+        {
+            return Fail<JsonValue>(state.position);
+        };
+    }
+
+    ParseResult<JsonValue> JsonParser::operator()(const std::string& string) const
+    {
+        scratch->depth = 0;
+        auto result = value(string);
+        if (result.Success() && result.GetPosition() != static_cast<int>(string.length()))
+            return Fail<JsonValue>(0);
+        return result;
+    }
+}
@@ -0,0 +1,136 @@
+#ifndef JSON_H
+#define JSON_H
+
+#include <string>
+#include <string_view>
+#include <span>
+#include <memory>
+#include <vector>
+#include "Parser.h"
+#include "Arena.h"
+
+namespace prs
+{
+    enum class JsonType : unsigned char
+    {
+        Null,
+        Boolean,
+        Number,
+        String,
+        Array,
+        Object
+    };
+
+    struct JsonMember;
+
+    /*
+    * A JSON value. Strings refer to the input or, when they contained escape sequences, to the arena of the parser,
+    * and arrays and objects are stored in the arena.
+    */
+    struct JsonValue
+    {
+        JsonType type = JsonType::Null;
+        union
+        {
+            bool boolean;
+            double number;
+            const char* characters;
+            const JsonValue* elements;
+            const JsonMember* members;
+        };
+        size_t size = 0;
+
+        JsonValue()
+            : number(0) { }
+
+        bool Boolean() const
+        {
+            return boolean;
+        }
+
+        double Number() const
+        {
+            return number;
+        }
+
+        std::string_view String() const
+        {
+            return std::string_view(characters, size);
+        }
+
+        std::span<const JsonValue> Array() const
+        {
+            return std::span<const JsonValue>(elements, size);
+        }
+
+        std::span<const JsonMember> Object() const;
+
+        /*
+        * Returns the value of the first member of an object with the specified name, or nullptr if there is none.
+        */
+        const JsonValue* Find(std::string_view name) const;
+    };
+
+    struct JsonMember
+    {
+        std::string_view name;
+        JsonValue value;
+    };
+
+    inline std::span<const JsonMember> JsonValue::Object() const
+    {
+        return std::span<const JsonMember>(members, size);
+    }
+
+    namespace detail
+    {
+        struct JsonScratch;
+    }
+
+    /*
+    * A parser for RFC 8259 JSON built from prs combinators, which returns a DOM allocated in an arena.
+    * Elements and members are collected on a stack shared by all nesting levels and copied to the arena once per array or object.
+    * An instance must not be used by several threads at the same time.
+    */
+    class JsonParser
+    {
+    private:
+        std::shared_ptr<Arena> arena;
+        std::shared_ptr<detail::JsonScratch> scratch;
+        std::shared_ptr<Parser<JsonValue>> valueReference;
+        Parser<JsonValue> value;
+
+        JsonParser(std::shared_ptr<Arena> arena, std::pair<Parser<JsonValue>, std::shared_ptr<Parser<JsonValue>>> forward);
+    public:
+        /*
+        * Nesting deeper than this is rejected, so malicious input cannot exhaust the call stack.
+        */
+        static constexpr int maximumDepth = 512;
+
+        explicit JsonParser(std::shared_ptr<Arena> arena = std::make_shared<Arena>());
+        ~JsonParser();
+
+        JsonParser(const JsonParser&) = delete;
+        JsonParser& operator=(const JsonParser&) = delete;
+
+        /*
+        * Parses an input that consists of one JSON value surrounded by optional whitespace.
+        */
+        ParseResult<JsonValue> operator()(const std::string& string) const;
+
+        /*
+        * Deleted because the strings of the result may refer to the input.
+        */
+        ParseResult<JsonValue> operator()(std::string&& string) const = delete;
+
+        /*
+        * Returns a parser for one JSON value surrounded by optional whitespace, for use inside other grammars.
+        */
+        const Parser<JsonValue>& Value() const
+        {
+            return value;
+        }
+    };
+}
+
+#endif
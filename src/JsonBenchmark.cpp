@@ -0,0 +1,137 @@
+#include <string>
+#include <random>
+#include <memory>
+#include <iostream>
+#include <cstdio>
+#include "Json.h"
+#include "Benchmark.h"
+
+/*
+* Measures JsonParser on generated documents shaped like the twitter.json, canada.json and citm_catalog.json files
+* commonly used to compare JSON parsers: string-heavy objects, arrays of floating-point coordinates,
+* and objects keyed by numeric ids with many small integer arrays.
+*/
+
+namespace
+{
+    std::mt19937 generator(42);
+
+    int Uniform(int low, int high)
+    {
+        return std::uniform_int_distribution<int>(low, high)(generator);
+    }
+
+    std::string Word()
+    {
+        std::string word;
+        int length = Uniform(3, 10);
+        for (int i = 0; i < length; ++i)
+            word += static_cast<char>('a' + Uniform(0, 25));
+        return word;
+    }
+
+    std::string Sentence(int words)
+    {
+        std::string sentence = Word();
+        for (int i = 1; i < words; ++i)
+            sentence += (i % 7 == 0 ? " \\u00e9\\n" : " ") + Word();
+        return sentence;
+    }
+
+    std::string Twitter(int statuses)
+    {
+        std::string json = "{\"statuses\":[";
+        for (int i = 0; i < statuses; ++i)
+        {
+            if (i > 0)
+                json += ",";
+            std::string id = std::to_string(505874924095815681ll + i);
+            json += "{\"created_at\":\"Sun Aug 31 00:29:15 +0000 2014\",\"id\":" + id + ",\"id_str\":\"" + id + "\","
+                "\"text\":\"" + Sentence(Uniform(5, 25)) + "\",\"truncated\":false,"
+                "\"user\":{\"id\":" + std::to_string(Uniform(1000, 1000000000)) + ",\"name\":\"" + Word() + "\","
+                "\"screen_name\":\"" + Word() + "\",\"description\":\"" + Sentence(Uniform(0, 1) ? 12 : 3) + "\","
+                "\"url\":null,\"followers_count\":" + std::to_string(Uniform(0, 100000)) + ",\"verified\":false},"
+                "\"entities\":{\"hashtags\":[],\"urls\":[{\"url\":\"http:\\/\\/t.co\\/" + Word() + "\",\"indices\":[" +
+                std::to_string(Uniform(0, 50)) + "," + std::to_string(Uniform(51, 140)) + "]}]},"
+                "\"retweet_count\":" + std::to_string(Uniform(0, 500)) + ",\"favorited\":false,\"lang\":\"ja\"}";
+        }
+        return json + "]}";
+    }
+
+    std::string Canada(int rings, int points)
+    {
+        std::uniform_real_distribution<double> longitude(-141.0, -52.0), latitude(41.0, 83.0);
+        std::string json = "{\"type\":\"FeatureCollection\",\"features\":[{\"type\":\"Feature\",\"properties\":{\"name\":\"Canada\"},"
+            "\"geometry\":{\"type\":\"Polygon\",\"coordinates\":[";
+        char buffer[64];
+        for (int i = 0; i < rings; ++i)
+        {
+            json += i > 0 ? ",[" : "[";
+            for (int j = 0; j < points; ++j)
+            {
+                std::snprintf(buffer, sizeof(buffer), "%s[%.15f,%.15f]", j > 0 ? "," : "", longitude(generator), latitude(generator));
+                json += buffer;
+            }
+            json += "]";
+        }
+        return json + "]}}]}";
+    }
+
+    std::string Citm(int events)
+    {
+        std::string json = "{\"areaNames\":{";
+        for (int i = 0; i < 200; ++i)
+            json += (i > 0 ? ",\"" : "\"") + std::to_string(205705993 + i) + "\":\"Arri\\u00e8re-sc\\u00e8ne " + Word() + "\"";
+        json += "},\"events\":{";
+        for (int i = 0; i < events; ++i)
+        {
+            std::string id = std::to_string(138586341 + i);
+            json += (i > 0 ? ",\"" : "\"") + id + "\":{\"description\":null,\"id\":" + id + ",\"logo\":null,\"name\":\"" +
+                Sentence(3) + "\",\"subTopicIds\":[337184269,337184283],\"subjectCode\":null,\"subtitle\":null,"
+                "\"topicIds\":[324846099,107888604]}";
+        }
+        json += "},\"performances\":[";
+        for (int i = 0; i < events; ++i)
+        {
+            json += (i > 0 ? "," : "") + std::string("{\"eventId\":") + std::to_string(138586341 + i) +
+                ",\"id\":" + std::to_string(339887544 + i) + ",\"logo\":null,\"name\":null,\"prices\":[";
+            int prices = Uniform(1, 6);
+            for (int j = 0; j < prices; ++j)
+                json += (j > 0 ? "," : "") + std::string("{\"amount\":") + std::to_string(Uniform(10, 200) * 250) +
+                    ",\"audienceSubCategoryId\":337100890,\"seatCategoryId\":" + std::to_string(338937295 + j) + "}";
+            json += "],\"seatCategories\":[{\"areas\":[{\"areaId\":205705999,\"blockIds\":[]},{\"areaId\":205705998,\"blockIds\":[]}],"
+                "\"seatCategoryId\":338937295}],\"seatMapImage\":null,\"start\":" + std::to_string(1372701600000ll + i * 86400000ll) +
+                ",\"venueCode\":\"PLEYEL_PLEYEL\"}";
+        }
+        return json + "]}";
+    }
+}
+
+int main()
+{
+    using namespace prs;
+
+    auto arena = std::make_shared<Arena>();
+    JsonParser json(arena);
+    std::pair<const char*, std::string> documents[] = {
+        { "twitter-shaped", Twitter(2000) },
+        { "canada-shaped", Canada(50, 2000) },
+        { "citm-shaped", Citm(2000) }
+    };
+    for (const auto& [name, document] : documents)
+    {
+        if (!json(document).Success())
+        {
+            std::cout << name << ": parse failed\n";
+            return 1;
+        }
+        double seconds = benchmark::Time([&]()
+        {
+            benchmark::Keep(json(document));
+            arena->Reset();
+        });
+        benchmark::ReportThroughput(std::string(name) + " (" + std::to_string(document.size() / 1024) + " KiB)",
+            seconds, static_cast<double>(document.size()));
+    }
+    return 0;
+}
@@ -0,0 +1,39 @@
+#include "KeyDispatch.h"
+
+namespace prs
+{
+    namespace detail
+    {
+        int KeyEnd(const std::string& string, int position)
+        {
+            int length = static_cast<int>(string.length());
+            if (position >= length)
+                return -1;
+            if (string[position] == '"')
+            {
+                size_t close = string.find('"', position + 1);
+                if (close == std::string::npos)
+                    return -1;
+                return static_cast<int>(close) + 1;
+            }
+            int begin = position;
+            while (position < length)
+            {
+                char c = string[position];
+                if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                    (c >= '0' && c <= '9') || c == '_' || c == '-')
+                    ++position;
+                else
+                    break;
+            }
+            return position > begin ? position : -1;
+        }
+
+        std::string_view KeyName(const std::string& string, int begin, int end)
+        {
+            if (string[begin] == '"')
+                return std::string_view(string.data() + begin + 1, end - begin - 2);
+            return std::string_view(string.data() + begin, end - begin);
+        }
+    }
+}
@@ -0,0 +1,63 @@
+#ifndef KEY_DISPATCH_H
+#define KEY_DISPATCH_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+#include <optional>
+#include <initializer_list>
+#include "Parser.h"
+#include "PerfectHash.h"
+
+namespace prs
+{
+    namespace detail
+    {
+        /*
+        * Returns the end of a key starting at position: either a run of letters, digits, '_' and '-',
+        * or a double-quoted key without escape sequences, including its quotes. Returns -1 if there is no key.
+        */
+        int KeyEnd(const std::string& string, int position);
+
+        /*
+        * Returns the key ending at end without its quotes.
+        */
+        std::string_view KeyName(const std::string& string, int begin, int end);
+    }
+
+    /*
+    * Returns a parser that reads a key and runs the parser registered for it directly after the key.
+    * Keys are looked up in a perfect hash built when the parser is created, without copying the key.
+    * Keys may be bare (name) or double-quoted ("name"). The skip parser runs after keys that are not registered.
+    */
+    template<typename T>
+    [[nodiscard]]
+    inline Parser<T> KeyDispatch(std::initializer_list<std::pair<std::string, Parser<T>>> entries, std::optional<Parser<T>> skip = std::nullopt)
+    {
+        std::vector<std::string> keys;
+        std::vector<Parser<T>> parsers;
+        for (const auto& entry : entries)
+        {
+            keys.push_back(entry.first);
+            parsers.push_back(entry.second);
+        }
+        PerfectHash table(std::move(keys));
+
+        return [=](const StringState& state, const std::string& string)
+        {
+            int end = detail::KeyEnd(string, state.position);
+            if (end < 0)
+                return Fail<T>(state.position);
+            int index = table.Find(detail::KeyName(string, state.position, end));
+            if (index < 0 && !skip.has_value())
+                return Fail<T>(state.position);
+            auto result = index >= 0 ? parsers[index](string, end) : (*skip)(string, end);
+            if (!result.Success())
+                return Fail<T>(state.position);
+            return result;
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,38 @@
+#include <string>
+#include <memory>
+#include "Parser.h"
+#include "Expectations.h"
+#include "Benchmark.h"
+
+/*
+* Measures the cost of Label on the success path by parsing the same valid input with and without labels.
+*/
+int main()
+{
+    using namespace prs;
+
+    auto expectations = std::make_shared<Expectations>();
+    auto count = [](int count, const Pair<std::string, int>&) { return count + 1; };
+
+    Parser<Pair<std::string, int>> plain = letters >> ~Char('=') >> integer;
+    Parser<Pair<std::string, int>> labelled = Label(expectations, letters, "identifier") >>
+        ~Label(expectations, Char('='), "'='") >> Label(expectations, integer, "number");
+    Parser<int> plainList = SepBy(plain, ~Char(';'), 0, count);
+    Parser<int> labelledList = SepBy(labelled, ~Char(';'), 0, count);
+
+    std::string input;
+    for (int i = 0; i < 100000; ++i)
+        input += "key" + std::string(1, static_cast<char>('a' + i % 26)) + "=" + std::to_string(i) + ";";
+    input.pop_back();
+
+    auto run = [&](const Parser<int>& parser)
+    {
+        return benchmark::Time([&]()
+        {
+            benchmark::Keep(parser(input));
+        });
+    };
+    benchmark::ReportThroughput("without Label", run(plainList), static_cast<double>(input.size()));
+    benchmark::ReportThroughput("with Label", run(labelledList), static_cast<double>(input.size()));
+    return 0;
+}
@@ -0,0 +1,147 @@
+#include <string>
+#include <vector>
+#include <random>
+#include <atomic>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include "Logs.h"
+#include "ThreadPool.h"
+#include "Benchmark.h"
+
+/*
+* Measures the log parsers on several gigabytes of RFC 5424 syslog, RFC 3164 syslog and Combined Log Format lines,
+* on one thread and on a thread pool. Positions are ints, so the log is held as blocks of 64 MiB that end at line breaks.
+* Only a few distinct blocks are generated, which are parsed over and over until the requested size has been read;
+* together they are much larger than any cache, so each pass reads them from memory like a fresh file would.
+* The size in gigabytes may be given as the first argument.
+*/
+
+namespace
+{
+    constexpr size_t blockSize = 64 << 20;
+    constexpr size_t distinctBlocks = 4;
+
+    std::mt19937 generator(11);
+
+    const char* months[] = { "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+    const char* hosts[] = { "mymachine.example.com", "db-01.internal", "10.1.2.3", "web-frontend-7" };
+    const char* paths[] = { "/", "/index.html", "/static/app.js", "/api/v1/users?page=2", "/images/logo.png" };
+
+    int Random(int bound)
+    {
+        return static_cast<int>(generator() % bound);
+    }
+
+    std::string Syslog5424Line()
+    {
+        char line[512];
+        std::snprintf(line, sizeof(line),
+            "<%d>1 2024-%02d-%02dT%02d:%02d:%02d.%03dZ %s app%d %d ID%d [exampleSDID@32473 iut=\"%d\" eventSource=\"Application\"] "
+            "An application event log entry number %d\n",
+            Random(192), 1 + Random(12), 1 + Random(28), Random(24), Random(60), Random(60), Random(1000),
+            hosts[Random(4)], Random(10), Random(100000), Random(100), Random(10), Random(1000000));
+        return line;
+    }
+
+    std::string Syslog3164Line()
+    {
+        char line[512];
+        std::snprintf(line, sizeof(line), "<%d>%s %2d %02d:%02d:%02d %s su[%d]: 'su root' failed for user%d on /dev/pts/%d\n",
+            Random(192), months[Random(12)], 1 + Random(28), Random(24), Random(60), Random(60),
+            hosts[Random(4)], Random(100000), Random(1000), Random(16));
+        return line;
+    }
+
+    std::string CombinedLine()
+    {
+        char line[512];
+        std::snprintf(line, sizeof(line),
+            "192.168.%d.%d - user%d [%02d/%s/2024:%02d:%02d:%02d -0700] \"%s %s HTTP/1.1\" %d %d "
+            "\"http://example.com/\" \"Mozilla/5.0 (X11; Linux x86_64) Gecko/20100101 Firefox/115.0\"\n",
+            Random(256), Random(256), Random(1000), 1 + Random(28), months[Random(12)], Random(24), Random(60), Random(60),
+            Random(4) == 0 ? "POST" : "GET", paths[Random(5)], Random(8) == 0 ? 404 : 200, Random(100000));
+        return line;
+    }
+
+    std::vector<std::string> Blocks(std::string (*line)())
+    {
+        std::vector<std::string> blocks(distinctBlocks);
+        for (std::string& block : blocks)
+        {
+            block.reserve(blockSize);
+            for (std::string next = line(); block.size() + next.size() <= blockSize; next = line())
+                block += next;
+        }
+        return blocks;
+    }
+
+    /*
+    * Parses every line of a block and returns the number of lines, exiting if one fails to parse.
+    */
+    template<typename T>
+    size_t ParseBlock(const prs::Parser<T>& parser, const std::string& block)
+    {
+        int length = static_cast<int>(block.length());
+        size_t lines = 0;
+        for (int position = 0; position < length; ++lines)
+        {
+            auto result = parser(block, position);
+            if (!result.Success())
+            {
+                std::cerr << "failed to parse the line at " << position << "\n";
+                std::exit(1);
+            }
+            prs::benchmark::Keep(result.GetResult());
+            position = result.GetPosition();
+        }
+        return lines;
+    }
+
+    template<typename T>
+    void Measure(const std::string& name, const prs::Parser<T>& parser, std::string (*line)(), double gigabytes)
+    {
+        using namespace prs;
+
+        std::vector<std::string> blocks = Blocks(line);
+        size_t passBytes = 0;
+        for (const std::string& block : blocks)
+            passBytes += block.size();
+        size_t count = std::max<size_t>(1, static_cast<size_t>(gigabytes * 1e9 / passBytes * blocks.size() + 0.5));
+        double bytes = 0;
+        for (size_t i = 0; i < count; ++i)
+            bytes += static_cast<double>(blocks[i % blocks.size()].size());
+
+        benchmark::ReportThroughput(name + ", single thread", benchmark::Time([&]()
+        {
+            size_t lines = 0;
+            for (size_t i = 0; i < count; ++i)
+                lines += ParseBlock(parser, blocks[i % blocks.size()]);
+            benchmark::Keep(lines);
+        }, 0), bytes);
+
+        ThreadPool& pool = ThreadPool::Shared();
+        benchmark::ReportThroughput(name + ", thread pool", benchmark::Time([&]()
+        {
+            std::atomic<size_t> lines = 0;
+            pool.ForEach(count, [&](size_t i)
+            {
+                lines += ParseBlock(parser, blocks[i % blocks.size()]);
+            });
+            benchmark::Keep(lines.load());
+        }, 0), bytes);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    using namespace prs;
+
+    double gigabytes = argc > 1 ? std::atof(argv[1]) : 4;
+    std::cout << "threads: " << ThreadPool::Shared().Size() << ", size: " << gigabytes << " GB\n";
+    Measure("syslog RFC 5424", syslog5424, Syslog5424Line, gigabytes);
+    Measure("syslog RFC 3164", Syslog3164(2024), Syslog3164Line, gigabytes);
+    Measure("combined log", combinedLog, CombinedLine, gigabytes);
+    return 0;
+}
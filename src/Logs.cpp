@@ -0,0 +1,368 @@
+#include "Logs.h"
+#include "Scan.h"
+#include <array>
+#include <cstring>
+#include <limits>
+
+namespace prs
+{
+    namespace
+    {
+        using CharacterClass = std::array<bool, 256>;
+
+        template<typename P>
+        constexpr CharacterClass Class(P predicate)
+        {
+            CharacterClass table{};
+            for (int c = 0; c < 256; ++c)
+                table[c] = predicate(static_cast<unsigned char>(c));
+            return table;
+        }
+
+        constexpr bool IsDigit(unsigned char c)
+        {
+            return c >= '0' && c <= '9';
+        }
+
+        constexpr CharacterClass decimalDigits = Class(IsDigit);
+
+        /*
+        * PRINTUSASCII of RFC 5424, of which the header fields consist.
+        */
+        constexpr CharacterClass printable = Class([](unsigned char c) { return c > ' ' && c < 0x7F; });
+
+        constexpr CharacterClass structuredDataName = Class([](unsigned char c)
+        {
+            return c > ' ' && c < 0x7F && c != '=' && c != ']' && c != '"';
+        });
+
+        constexpr CharacterClass tagCharacters = Class([](unsigned char c)
+        {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || IsDigit(c) || c == '-' || c == '_' || c == '.' || c == '/';
+        });
+
+        /*
+        * Anything but spaces and control characters, of which the unquoted fields of access logs consist.
+        */
+        constexpr CharacterClass unquoted = Class([](unsigned char c) { return c > ' ' && c != 0x7F; });
+
+        constexpr int unbounded = std::numeric_limits<int>::max();
+
+        /*
+        * Returns a parser for one to maximum characters of a class, which returns them as a view into the input.
+        */
+        Parser<std::string_view> Run(const CharacterClass& characters, int maximum)
+        {
+            const CharacterClass* table = &characters;
+            return [table, maximum](const StringState& state, const std::string& string)
+            {
+                const char* data = string.data();
+                int length = static_cast<int>(string.length());
+                int end = maximum < length - state.position ? state.position + maximum : length;
+                int position = state.position;
+                while (position < end && (*table)[static_cast<unsigned char>(data[position])])
+                    ++position;
+                if (position == state.position)
+                    return Fail<std::string_view>(state.position);
+                return Success(position, std::string_view(data + state.position, position - state.position));
+            };
+        }
+
+        /*
+        * Parses a field in double quotes, in which any character may be escaped with '\', and which may not span lines.
+        * Returns the content without the quotes, leaving the escape sequences in place.
+        */
+        Parser<std::string_view> Quoted()
+        {
+            return [](const StringState& state, const std::string& string)
+            {
+                const char* data = string.data();
+                const char* end = data + string.length();
+                const char* begin = data + state.position;
+                if (begin >= end || *begin != '"')
+                    return Fail<std::string_view>(state.position);
+                const char* close = scan::FindFirstOf(begin + 1, end, '"', '\\');
+                while (close < end && *close == '\\')
+                    close = close + 1 < end ? scan::FindFirstOf(close + 2, end, '"', '\\') : end;
+                if (close >= end || std::memchr(begin + 1, '\n', close - begin - 1) != nullptr)
+                    return Fail<std::string_view>(state.position);
+                return Success(static_cast<int>(close + 1 - data), std::string_view(begin + 1, close - begin - 1));
+            };
+        }
+
+        /*
+        * Parses the rest of the line and its line break, and returns the line without a CR before the LF.
+        */
+        Parser<std::string_view> RestOfLine()
+        {
+            return [](const StringState& state, const std::string& string)
+            {
+                const char* data = string.data();
+                int length = static_cast<int>(string.length());
+                if (state.position > length)
+                    return Fail<std::string_view>(state.position);
+                int end = static_cast<int>(scan::FindFirstOf(data + state.position, data + length, '\n', '\n') - data);
+                int next = end == length ? length : end + 1;
+                if (end > state.position && data[end - 1] == '\r')
+                    --end;
+                return Success(next, std::string_view(data + state.position, end - state.position));
+            };
+        }
+
+        /*
+        * Parses LF, CRLF or the end of the input.
+        */
+        Parser<Void> LineBreak()
+        {
+            return [](const StringState& state, const std::string& string)
+            {
+                int length = static_cast<int>(string.length());
+                int position = state.position;
+                if (position < length && string[position] == '\r')
+                    ++position;
+                if (position < length && string[position] == '\n')
+                    return Success(position + 1, Void());
+                if (state.position == length)
+                    return Success(length, Void());
+                return Fail<Void>(state.position);
+            };
+        }
+
+        /*
+        * Returns a parser that fails when the result of parser does not satisfy predicate.
+        */
+        template<typename T, typename P>
+        Parser<T> Where(const Parser<T>& parser, const P& predicate)
+        {
+            return [parser, predicate](const StringState& state, const std::string& string)
+            {
+                auto result = parser(string, state.position);
+                if (!result.Success() || !predicate(result.GetResult()))
+                    return Fail<T>(state.position);
+                return result;
+            };
+        }
+
+        /*
+        * Returns a parser for zero or more occurrences of parser, which keeps none of their results.
+        */
+        template<typename T>
+        Parser<Void> SkipMany(const Parser<T>& parser)
+        {
+            return [parser](const StringState& state, const std::string& string)
+            {
+                int position = state.position;
+                for (auto result = parser(string, position); result.Success(); result = parser(string, position))
+                    position = result.GetPosition();
+                return Success(position, Void());
+            };
+        }
+
+        /*
+        * Returns a parser that runs parser and returns the part of the input it consumed.
+        */
+        template<typename T>
+        Parser<std::string_view> Consumed(const Parser<T>& parser)
+        {
+            return [parser](const StringState& state, const std::string& string)
+            {
+                auto result = parser(string, state.position);
+                if (!result.Success())
+                    return Fail<std::string_view>(state.position);
+                return Success(result.GetPosition(),
+                    std::string_view(string.data() + state.position, result.GetPosition() - state.position));
+            };
+        }
+
+        /*
+        * Returns a parser for a field that may be "-" for a missing value, which is returned as empty.
+        */
+        Parser<std::string_view> Nil(const Parser<std::string_view>& field)
+        {
+            return field | [](std::string_view value) { return value == "-" ? std::string_view() : value; };
+        }
+
+        /*
+        * Returns a parser that runs message and then field, and passes the message and the result of field to assign.
+        * The message is filled in place rather than passed through a Pair, since it is built up one field at a time.
+        */
+        template<typename T, typename U, typename F>
+        Parser<T> Fill(const Parser<T>& message, const Parser<U>& field, const F& assign)
+        {
+            return [message, field, assign](const StringState& state, const std::string& string)
+            {
+                auto result = message(string, state.position);
+                if (!result.Success())
+                    return result;
+                auto fieldResult = field(string, result.GetPosition());
+                if (!fieldResult.Success())
+                    return Fail<T>(state.position);
+                assign(result.GetResult(), fieldResult.GetResult());
+                return Success(fieldResult.GetPosition(), std::move(result.GetResult()));
+            };
+        }
+
+        /*
+        * Returns a parser that runs message and then field, and stores the result of field in a member of the message.
+        */
+        template<typename T, typename U, typename M>
+        Parser<T> Store(const Parser<T>& message, const Parser<U>& field, M T::* member)
+        {
+            return Fill(message, field, [member](T& value, U& fieldValue) { value.*member = std::move(fieldValue); });
+        }
+
+        std::int64_t Value(std::string_view digits)
+        {
+            std::int64_t value = 0;
+            for (char c : digits)
+                value = value * 10 + (c - '0');
+            return value;
+        }
+
+        /*
+        * Parses a single character without returning it, like ~Char(character) but in one step.
+        */
+        Parser<Void> Literal(char character)
+        {
+            return [character](const StringState& state, const std::string& string)
+            {
+                if (state.position >= static_cast<int>(string.length()) || string[state.position] != character)
+                    return Fail<Void>(state.position);
+                return Success(state.position + 1, Void());
+            };
+        }
+
+        Parser<Void> Space()
+        {
+            return Literal(' ');
+        }
+
+        /*
+        * Parses <PRI>, a priority of at most 191 without leading zeros, and starts a message with its facility and severity.
+        */
+        Parser<SyslogMessage> Priority()
+        {
+            Parser<std::string_view> priority = Literal('<') >> Run(decimalDigits, 3) >> Literal('>');
+            return Where(priority, [](std::string_view value) { return (value.length() == 1 || value[0] != '0') && Value(value) <= 191; }) |
+                [](std::string_view value)
+                {
+                    SyslogMessage message{};
+                    message.facility = static_cast<int>(Value(value) / 8);
+                    message.severity = static_cast<int>(Value(value) % 8);
+                    return message;
+                };
+        }
+
+        std::optional<Timestamp> Present(const Timestamp& time)
+        {
+            return time;
+        }
+
+        Parser<SyslogMessage> Syslog5424Grammar()
+        {
+            Parser<int> version = Where(Run(decimalDigits, 2), [](std::string_view value) { return value[0] != '0'; }) |
+                [](std::string_view value) { return static_cast<int>(Value(value)); };
+            Parser<std::optional<Timestamp>> timestamp = (Literal('-') | [](Void) { return std::optional<Timestamp>(); }) ||
+                (rfc3339 | &Present);
+
+            /*
+            * Structured data is "-" or one or more elements such as [id param="value"], and is returned as written.
+            */
+            Parser<Void> name = ~Run(structuredDataName, 32);
+            Parser<Void> parameter = name >> Literal('=') >> ~Quoted();
+            Parser<Void> element = Literal('[') >> name >> SkipMany(Space() >> parameter) >> Literal(']');
+            Parser<std::string_view> structuredData = (Literal('-') | [](Void) { return std::string_view(); }) ||
+                Consumed(element >> SkipMany(element));
+            Parser<std::string_view> content = (Space() >> RestOfLine()) || (LineBreak() | [](Void) { return std::string_view(); });
+
+            Parser<SyslogMessage> message = Store(Priority(), version, &SyslogMessage::version);
+            message = Store(message, Space() >> timestamp, &SyslogMessage::timestamp);
+            message = Store(message, Space() >> Nil(Run(printable, 255)), &SyslogMessage::hostname);
+            message = Store(message, Space() >> Nil(Run(printable, 48)), &SyslogMessage::appName);
+            message = Store(message, Space() >> Nil(Run(printable, 128)), &SyslogMessage::processId);
+            message = Store(message, Space() >> Nil(Run(printable, 32)), &SyslogMessage::messageId);
+            message = Store(message, Space() >> structuredData, &SyslogMessage::structuredData);
+            return Store(message, content, &SyslogMessage::message);
+        }
+
+        void SplitRequest(AccessLogEntry& entry)
+        {
+            std::string_view request = entry.request;
+            size_t first = request.find(' ');
+            size_t last = request.rfind(' ');
+            if (first == std::string_view::npos || first == last || request.find(' ', first + 1) != last)
+                return;
+            entry.method = request.substr(0, first);
+            entry.target = request.substr(first + 1, last - first - 1);
+            entry.protocol = request.substr(last + 1);
+        }
+
+        Parser<AccessLogEntry> CombinedLogGrammar()
+        {
+            Parser<std::string_view> field = Quoted() || Run(unquoted, unbounded);
+            Parser<int> status = Where(Run(decimalDigits, 3), [](std::string_view value) { return value.length() == 3; }) |
+                [](std::string_view value) { return static_cast<int>(Value(value)); };
+            Parser<std::int64_t> bytes = (Run(decimalDigits, 18) | &Value) || (Literal('-') | [](Void) { return std::int64_t(-1); });
+
+            /*
+            * The Combined Log Format adds the referer and user agent to the Common Log Format.
+            */
+            using Trailer = Pair<std::string_view, std::string_view>;
+            Parser<Trailer> refererAndUserAgent = Try(Space() >> Quoted() >> Space() >> Quoted(), Trailer{}) >> LineBreak();
+
+            Parser<AccessLogEntry> entry = field | [](std::string_view host)
+            {
+                AccessLogEntry entry{};
+                entry.remoteHost = host;
+                return entry;
+            };
+            entry = Store(entry, Space() >> field, &AccessLogEntry::identity);
+            entry = Store(entry, Space() >> field, &AccessLogEntry::user);
+            entry = Store(entry, Space() >> Literal('[') >> clf >> Literal(']'), &AccessLogEntry::time);
+            entry = Fill(entry, Space() >> Quoted(), [](AccessLogEntry& entry, std::string_view request)
+            {
+                entry.request = request;
+                SplitRequest(entry);
+            });
+            entry = Store(entry, Space() >> status, &AccessLogEntry::status);
+            entry = Store(entry, Space() >> bytes, &AccessLogEntry::bytes);
+            return Fill(entry, refererAndUserAgent, [](AccessLogEntry& entry, const Trailer& trailer)
+            {
+                entry.referer = trailer.first;
+                entry.userAgent = trailer.second;
+            });
+        }
+    }
+
+    /*
+    * The grammars use the timestamp parsers of another translation unit, so they are built on first use
+    * rather than during static initialization.
+    */
+    Parser<SyslogMessage> syslog5424 = [](const StringState& state, const std::string& string)
+    {
+        static const Parser<SyslogMessage> grammar = Syslog5424Grammar();
+        return grammar(string, state.position);
+    };
+
+    Parser<SyslogMessage> Syslog3164(int year)
+    {
+        using Tag = Pair<std::string_view, std::string_view>;
+        Parser<std::string_view> processId = Try(Literal('[') >> Run(decimalDigits, unbounded) >> Literal(']'), std::string_view());
+        Parser<Tag> tag = Run(tagCharacters, 32) >> processId >> Literal(':') >> Try(Space(), Void());
+
+        Parser<SyslogMessage> message = Store(Priority(), Rfc3164Timestamp(year) | &Present, &SyslogMessage::timestamp);
+        message = Store(message, Space() >> Nil(Run(printable, 255)), &SyslogMessage::hostname);
+        return Fill(message, Space() >> Try(tag, Tag{}) >> RestOfLine(), [](SyslogMessage& message, const Pair<Tag, std::string_view>& rest)
+        {
+            message.appName = rest.first.first;
+            message.processId = rest.first.second;
+            message.message = rest.second;
+        });
+    }
+
+    Parser<AccessLogEntry> combinedLog = [](const StringState& state, const std::string& string)
+    {
+        static const Parser<AccessLogEntry> grammar = CombinedLogGrammar();
+        return grammar(string, state.position);
+    };
+}
@@ -0,0 +1,94 @@
+#ifndef LOGS_H
+#define LOGS_H
+
+#include <string>
+#include <string_view>
+#include <optional>
+#include <cstdint>
+#include "Parser.h"
+#include "Timestamps.h"
+
+/*
+*
+* Parsers for common log formats. Each parser reads one line including its line break, which may be LF or CRLF,
+* and returns views into the input.
+*
+*/
+
+namespace prs
+{
+    /*
+    * A syslog message. Fields that are absent or given as the nil value "-" are empty.
+    */
+    struct SyslogMessage
+    {
+        int facility;
+        int severity;
+        /*
+        * The version of an RFC 5424 message, or 0 for an RFC 3164 message.
+        */
+        int version;
+        std::optional<Timestamp> timestamp;
+        std::string_view hostname;
+        std::string_view appName;
+        std::string_view processId;
+        std::string_view messageId;
+        /*
+        * The structured data elements including their brackets, unparsed.
+        */
+        std::string_view structuredData;
+        std::string_view message;
+    };
+
+    /*
+    * Parses an RFC 5424 syslog message such as
+    * <165>1 2003-10-11T22:14:15.003Z mymachine.example.com evntslog - ID47 [exampleSDID@32473 iut="3"] An application event
+    */
+    extern Parser<SyslogMessage> syslog5424;
+
+    /*
+    * Returns a parser for an RFC 3164 syslog message such as <34>Oct 11 22:14:15 mymachine su[230]: 'su root' failed,
+    * whose timestamp is taken to be in the given year. The tag and process id are returned as appName and processId
+    * when the content starts with them.
+    */
+    [[nodiscard]]
+    Parser<SyslogMessage> Syslog3164(int year);
+
+    /*
+    * An entry of the Common or Combined Log Format written by Apache and Nginx.
+    * Quoted fields are returned without their quotes but with their escape sequences.
+    */
+    struct AccessLogEntry
+    {
+        std::string_view remoteHost;
+        std::string_view identity;
+        std::string_view user;
+        Timestamp time;
+        std::string_view request;
+        /*
+        * The parts of the request, which are empty when it does not consist of three words.
+        */
+        std::string_view method;
+        std::string_view target;
+        std::string_view protocol;
+        int status;
+        /*
+        * The size of the response, or -1 when it is given as "-".
+        */
+        std::int64_t bytes;
+        /*
+        * The last two fields of the Combined Log Format, which are empty for the Common Log Format.
+        */
+        std::string_view referer;
+        std::string_view userAgent;
+    };
+
+    /*
+    * Parses a line of the Combined Log Format, such as
+    * 127.0.0.1 - frank [10/Oct/2000:13:55:36 -0700] "GET /a.gif HTTP/1.0" 200 2326 "http://example.com/" "Mozilla/4.08"
+    * or of the Common Log Format, which lacks the referer and user agent.
+    */
+    extern Parser<AccessLogEntry> combinedLog;
+}
+
+#endif
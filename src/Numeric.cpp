@@ -0,0 +1,53 @@
+#include "Numeric.h"
+#include "Scan.h"
+
+namespace prs
+{
+    Parser<IntegerBatch> IntegerColumn(char separator, char terminator)
+    {
+        return [=](const StringState& state, const std::string& string)
+        {
+            const char* data = string.data();
+            int length = static_cast<int>(string.length());
+            if (state.position >= length)
+                return Fail<IntegerBatch>(state.position);
+
+            std::vector<Span> spans;
+            int begin = state.position;
+            int position;
+            while (true)
+            {
+                int end = static_cast<int>(scan::FindFirstOf(data + begin, data + length, separator, terminator) - data);
+                int valueEnd = end;
+                if (end < length && data[end] == '\n' && end > begin && data[end - 1] == '\r')
+                    --valueEnd;
+                spans.push_back({ begin, valueEnd });
+                if (end == length || (data[end] == separator && separator == terminator && end + 1 == length))
+                {
+                    position = length;
+                    break;
+                }
+                if (data[end] != separator)
+                {
+                    position = end;
+                    break;
+                }
+                begin = end + 1;
+            }
+
+            IntegerBatch batch;
+            batch.values.resize(spans.size());
+            batch.validity.assign((spans.size() + 63) / 64, 0);
+            for (size_t i = 0; i < spans.size(); ++i)
+            {
+                std::int64_t value;
+                if (swar::ParseInteger(data + spans[i].begin, spans[i].end - spans[i].begin, data + length, value))
+                {
+                    batch.values[i] = value;
+                    batch.validity[i / 64] |= std::uint64_t(1) << (i % 64);
+                }
+            }
+            return Success(position, std::move(batch));
+        };
+    }
+}
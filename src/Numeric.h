@@ -0,0 +1,43 @@
+#ifndef NUMERIC_H
+#define NUMERIC_H
+
+#include <vector>
+#include <cstdint>
+#include "Parser.h"
+
+namespace prs
+{
+    /*
+    * A column of 64-bit integers with a validity bitmap.
+    * Bit i % 64 of validity[i / 64] is set when value i was a well-formed integer; invalid and empty values are stored as 0.
+    */
+    struct IntegerBatch
+    {
+        std::vector<std::int64_t> values;
+        std::vector<std::uint64_t> validity;
+
+        size_t Size() const
+        {
+            return values.size();
+        }
+
+        bool IsValid(size_t index) const
+        {
+            return (validity[index / 64] >> (index % 64)) & 1;
+        }
+    };
+
+    /*
+    * Returns a parser for a list of integers separated by a separator and ended by a terminator or the end of the input.
+    * The terminator is not consumed. When the separator and the terminator are the same character,
+    * the list only ends at the end of the input, and a final separator does not start an empty value.
+    * The values are located first and then each is converted eight digits at a time within a 64-bit register.
+    * Values have different widths, so converting several of them in one vector register would first need a gather
+    * into fixed-width lanes, which costs about as much as the conversion itself.
+    * Values that do not follow the syntax of prs::integer or that do not fit in 64 bits are marked as invalid instead of failing the parse.
+    */
+    [[nodiscard]]
+    Parser<IntegerBatch> IntegerColumn(char separator, char terminator);
+}
+
+#endif
@@ -0,0 +1,76 @@
+#include "OnDemand.h"
+#include "Fields.h"
+#include <charconv>
+#include <cstring>
+
+namespace prs
+{
+    namespace
+    {
+        template<typename T>
+        std::optional<T> Convert(std::string_view text)
+        {
+            T value;
+            const char* end = text.data() + text.size();
+            auto [pointer, error] = std::from_chars(text.data(), end, value);
+            if (error != std::errc() || pointer != end)
+                return std::nullopt;
+            return value;
+        }
+    }
+
+    std::optional<std::int64_t> LazyRecord::Integer(size_t index) const
+    {
+        return Convert<std::int64_t>(View(index));
+    }
+
+    std::optional<double> LazyRecord::Double(size_t index) const
+    {
+        return Convert<double>(View(index));
+    }
+
+    std::string_view LazyRecord::String(size_t index, Arena& arena) const
+    {
+        std::string_view text = View(index);
+        if (text.length() < 2 || text.front() != quote)
+            return text;
+        text = text.substr(1, text.length() - 2);
+        size_t doubled = text.find(quote);
+        if (doubled == std::string_view::npos)
+            return text;
+        char* buffer = static_cast<char*>(arena.Allocate(text.length(), 1));
+        char* out = buffer;
+        while (doubled != std::string_view::npos)
+        {
+            std::memcpy(out, text.data(), doubled + 1);
+            out += doubled + 1;
+            text.remove_prefix(doubled + 2);
+            doubled = text.find(quote);
+        }
+        std::memcpy(out, text.data(), text.length());
+        out += text.length();
+        return std::string_view(buffer, out - buffer);
+    }
+
+    Parser<LazyRecord> OnDemandRecord(char delimiter, int fieldCount, char quote)
+    {
+        return [=](const StringState& state, const std::string& string)
+        {
+            if (state.position >= static_cast<int>(string.length()))
+                return Fail<LazyRecord>(state.position);
+
+            std::vector<Span> fields;
+            if (fieldCount >= 0)
+                fields.reserve(fieldCount);
+            auto store = [&](int, const Span& span)
+            {
+                fields.push_back(span);
+            };
+            int next = state.position;
+            int found = detail::SplitRecord(string, state.position, delimiter, quote, store, next);
+            if (found < 0 || (fieldCount >= 0 && found != fieldCount))
+                return Fail<LazyRecord>(state.position);
+            return Success(next, LazyRecord(string, std::move(fields), quote));
+        };
+    }
+}
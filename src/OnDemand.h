@@ -0,0 +1,92 @@
+#ifndef ON_DEMAND_H
+#define ON_DEMAND_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <optional>
+#include <cstdint>
+#include <memory>
+#include "Parser.h"
+#include "Arena.h"
+#include "Fields.h"
+
+namespace prs
+{
+    /*
+    * A delimited record whose fields have been located but not converted.
+    * Fields are converted only when they are accessed, so unused fields cost nothing beyond the structural scan.
+    * The record refers to the input, which must outlive it.
+    */
+    class LazyRecord
+    {
+    private:
+        const std::string* string = nullptr;
+        std::vector<Span> fields;
+        char quote = '"';
+    public:
+        LazyRecord() { }
+
+        LazyRecord(const std::string& string, std::vector<Span> fields, char quote = '"')
+            : string(&string), fields(std::move(fields)), quote(quote) { }
+
+        size_t Size() const
+        {
+            return fields.size();
+        }
+
+        const Span& GetSpan(size_t index) const
+        {
+            return fields[index];
+        }
+
+        /*
+        * Returns the unconverted text of a field, including the quotes of a quoted field.
+        */
+        std::string_view View(size_t index) const
+        {
+            const Span& span = fields[index];
+            return std::string_view(string->data() + span.begin, span.end - span.begin);
+        }
+
+        /*
+        * Converts a field with a parser, which runs on a copy of the field and must consume all of it.
+        * Its result must not refer to the input, which is checked at compile time for views and spans.
+        */
+        template<typename T>
+        std::optional<T> Get(size_t index, const Parser<T>& parser) const
+        {
+            const Span& span = fields[index];
+            std::optional<T> result;
+            detail::ParseIsolated(parser, *string, span.begin, span.end, result);
+            return result;
+        }
+
+        /*
+        * Converts a field holding a decimal integer.
+        */
+        std::optional<std::int64_t> Integer(size_t index) const;
+
+        /*
+        * Converts a field holding a floating-point number.
+        */
+        std::optional<double> Double(size_t index) const;
+
+        /*
+        * Returns the text of a field with its quotes removed. Fields without doubled quotes are returned as a view into the input,
+        * other fields are unescaped into the arena.
+        */
+        std::string_view String(size_t index, Arena& arena) const;
+    };
+
+    /*
+    * Returns a parser for a record of fields separated by a delimiter and terminated by a line break or the end of the input.
+    * A field starting with the quote character extends to the matching quote, where two quotes in a row stand for one quote,
+    * so it may contain delimiters and line breaks. The parser only locates the fields and consumes the line break.
+    * When fieldCount is not negative, records with a different number of fields are rejected.
+    */
+    [[nodiscard]]
+    Parser<LazyRecord> OnDemandRecord(char delimiter, int fieldCount = -1, char quote = '"');
+}
+
+#endif
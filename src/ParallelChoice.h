@@ -0,0 +1,144 @@
+#ifndef PARALLEL_CHOICE_H
+#define PARALLEL_CHOICE_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <optional>
+#include <exception>
+#include <initializer_list>
+#include "Parser.h"
+#include "ThreadPool.h"
+#include "Interruptible.h"
+
+namespace prs
+{
+    namespace detail
+    {
+        /*
+        * The number of checkpoints between two checks of whether a speculative alternative has been cancelled.
+        */
+        constexpr std::int64_t cancellationInterval = 1024;
+
+        template<typename T>
+        struct ParallelBranch
+        {
+            std::atomic<bool> claimed = false;
+            bool done = false;
+            std::optional<ParseResult<T>> result;
+            std::exception_ptr exception;
+        };
+
+        template<typename T>
+        struct ParallelChoiceState
+        {
+            std::unique_ptr<ParallelBranch<T>[]> branches;
+            std::atomic<size_t> winner;
+            std::mutex mutex;
+            std::condition_variable finished;
+
+            explicit ParallelChoiceState(size_t count)
+                : branches(std::make_unique<ParallelBranch<T>[]>(count)), winner(count) { }
+
+            /*
+            * Runs alternative index unless it has already been claimed by another thread.
+            */
+            void Run(size_t index, const Parser<T>& parser, const std::string& string, int position)
+            {
+                ParallelBranch<T>& branch = branches[index];
+                if (branch.claimed.exchange(true))
+                    return;
+                if (winner.load() > index)
+                {
+                    CancellationScope scope(winner, index, cancellationInterval);
+                    try
+                    {
+                        branch.result.emplace(parser(string, position));
+                    }
+                    catch (const ParseCancelled&)
+                    {
+                    }
+                    catch (...)
+                    {
+                        branch.exception = std::current_exception();
+                    }
+                }
+                std::lock_guard lock(mutex);
+                branch.done = true;
+                finished.notify_all();
+            }
+
+            /*
+            * Waits for an alternative that another thread has claimed.
+            */
+            void Wait(size_t index)
+            {
+                std::unique_lock lock(mutex);
+                finished.wait(lock, [&]() { return branches[index].done; });
+            }
+
+            /*
+            * Cancels the alternatives after index, and waits for those that are running, since they refer to the input.
+            */
+            void CancelAfter(size_t index, size_t count)
+            {
+                winner.store(index);
+                for (size_t i = index + 1; i < count; ++i)
+                    if (branches[i].claimed.exchange(true))
+                        Wait(i);
+            }
+        };
+    }
+
+    /*
+    * Returns a parser that tries all alternatives at the same position concurrently on a thread pool,
+    * and returns the result of the first alternative in order that succeeds, exactly like chaining them with ||.
+    * Once an alternative is known to be the answer, the alternatives after it are cancelled at their next Checkpoint.
+    * The calling thread runs the first alternative itself, and any alternative that no worker has picked up yet.
+    */
+    template<typename T>
+    [[nodiscard]]
+    inline Parser<T> ParallelChoice(std::initializer_list<Parser<T>> alternatives, ThreadPool& pool = ThreadPool::Shared())
+    {
+        std::vector<Parser<T>> p = alternatives;
+        ThreadPool* threads = &pool;
+        return [p, threads](const StringState& state, const std::string& string)
+        {
+            size_t count = p.size();
+            auto shared = std::make_shared<detail::ParallelChoiceState<T>>(count);
+            const std::string* input = &string;
+            int position = state.position;
+            for (size_t i = 1; i < count; ++i)
+            {
+                const Parser<T>* parser = &p[i];
+                threads->Submit([shared, i, parser, input, position]()
+                {
+                    shared->Run(i, *parser, *input, position);
+                });
+            }
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                shared->Run(i, p[i], string, state.position);
+                shared->Wait(i);
+                auto& branch = shared->branches[i];
+                if (branch.exception)
+                {
+                    shared->CancelAfter(i, count);
+                    std::rethrow_exception(branch.exception);
+                }
+                if (branch.result.has_value() && branch.result->Success())
+                {
+                    shared->CancelAfter(i, count);
+                    return std::move(*branch.result);
+                }
+            }
+            return Fail<T>(state.position);
+        };
+    }
+}
+
+#endif
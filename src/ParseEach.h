@@ -0,0 +1,118 @@
+#ifndef PARSE_EACH_H
+#define PARSE_EACH_H
+
+#include <string>
+#include <optional>
+#include <ranges>
+#include <iterator>
+#include <cstddef>
+#include "Parser.h"
+
+namespace prs
+{
+    /*
+    * A lazy input range of the results of applying a parser repeatedly to an input.
+    * A result is only parsed when the range is advanced to it, and only the current result is kept in memory.
+    * Iteration ends at the end of the input or when the parser fails or stops consuming input.
+    */
+    template<typename T>
+    class ParseEachView : public std::ranges::view_interface<ParseEachView<T>>
+    {
+    private:
+        Parser<T> parser;
+        const std::string* string = nullptr;
+        int position = 0;
+        std::optional<T> current;
+
+        void Next()
+        {
+            current.reset();
+            if (position >= static_cast<int>(string->length()))
+                return;
+            auto result = parser(*string, position);
+            if (!result.Success() || result.GetPosition() == position)
+                return;
+            position = result.GetPosition();
+            current.emplace(std::move(result.GetResult()));
+        }
+    public:
+        class Iterator
+        {
+        private:
+            ParseEachView* view = nullptr;
+        public:
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using iterator_concept = std::input_iterator_tag;
+
+            Iterator() { }
+
+            explicit Iterator(ParseEachView* view)
+                : view(view) { }
+
+            T& operator*() const
+            {
+                return *view->current;
+            }
+
+            Iterator& operator++()
+            {
+                view->Next();
+                return *this;
+            }
+
+            void operator++(int)
+            {
+                view->Next();
+            }
+
+            bool operator==(std::default_sentinel_t) const
+            {
+                return !view->current.has_value();
+            }
+        };
+
+        ParseEachView() { }
+
+        ParseEachView(const Parser<T>& parser, const std::string& string, int position)
+            : parser(parser), string(&string), position(position) { }
+
+        /*
+        * Parses the first result. Like any input range, the view can only be iterated once.
+        */
+        Iterator begin()
+        {
+            Next();
+            return Iterator(this);
+        }
+
+        std::default_sentinel_t end() const
+        {
+            return std::default_sentinel;
+        }
+
+        /*
+        * Returns the position after the last result parsed so far.
+        */
+        int GetPosition() const
+        {
+            return position;
+        }
+    };
+
+    /*
+    * Returns a lazy range of the results of applying a parser repeatedly to an input, beginning at a specified position.
+    * The input must outlive the range.
+    */
+    template<typename T>
+    [[nodiscard]]
+    inline ParseEachView<T> ParseEach(const Parser<T>& parser, const std::string& string, int position = 0)
+    {
+        return ParseEachView<T>(parser, string, position);
+    }
+
+    template<typename T>
+    ParseEachView<T> ParseEach(const Parser<T>& parser, const std::string&& string, int position = 0) = delete;
+}
+
+#endif
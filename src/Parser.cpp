@@ -166,6 +166,7 @@ namespace prs
                 if (c1 == '0' && c2 >= '0' && c2 <= '9')
                     return Fail<int>(state.position);
 
+                int digitsStart = position;
                 while (true)
                 {
                     c = string[position];
@@ -174,6 +175,8 @@ namespace prs
                     else
                         break;
                 }
+                if (position == digitsStart)
+                    return Fail<int>(state.position);
                 int count = position - state.position;
                 int result = std::stoi(string.substr(state.position, count));
                 return Success(position, result);
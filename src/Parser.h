@@ -7,6 +7,11 @@
 #include <initializer_list>
 #include <optional>
 #include <functional>
+#include <utility>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+#include <type_traits>
 
 /*
 * 
@@ -72,6 +77,15 @@ namespace prs
         T2 second;
     };
 
+    /*
+    * The start and end positions of a part of the input.
+    */
+    struct Span
+    {
+        int begin;
+        int end;
+    };
+
     /*
     * A struct used as returntype of parsers that do not return a meaningful result.
     */
@@ -266,6 +280,113 @@ namespace prs
         };
     }
 
+    /*
+    * Returns a parser that forwards to the parser stored in the returned reference, for defining recursive grammars.
+    * Until the reference is assigned, the parser fails.
+    * The parser keeps the reference alive, so a grammar that refers to itself is only released after the reference is reassigned.
+    */
+    template<typename T>
+    [[nodiscard]]
+    inline std::pair<Parser<T>, std::shared_ptr<Parser<T>>> CreateParserForwardedToRef()
+    {
+        auto reference = std::make_shared<Parser<T>>([](const StringState& state, const std::string&)
+        {
+            return Fail<T>(state.position);
+        });
+        Parser<T> parser = [reference](const StringState& state, const std::string& string)
+        {
+            return (*reference)(string, state.position);
+        };
+        return { parser, reference };
+    }
+
+    /*
+    * Returns a parser that applies parser and then the parser returned by function for its result,
+    * which makes the rest of the grammar depend on what has been parsed, such as a length or a tag.
+    */
+    template<typename T, typename F>
+    [[nodiscard]]
+    inline auto Bind(const Parser<T>& parser, const F& function)
+    {
+        using ReturnType = typename decltype(function(ParseResult<T>().GetResult()))::ReturnType;
+
+        Parser<ReturnType> p = [=](const StringState& state, const std::string& string)
+        {
+            auto result = parser(string, state.position);
+            if (!result.Success())
+                return Fail<ReturnType>(state.position);
+            auto continuation = function(result.GetResult())(string, result.GetPosition());
+            if (!continuation.Success())
+                return Fail<ReturnType>(state.position);
+            return continuation;
+        };
+        return p;
+    }
+
+    /*
+    * Operator equivalent of Bind.
+    */
+    template<typename T, typename F>
+    [[nodiscard]]
+    inline auto operator>>=(const Parser<T>& parser, const F& function)
+    {
+        return Bind(parser, function);
+    }
+
+    /*
+    * Like Bind, but for results that are small non-negative integers or enumerators, such as tags.
+    * The continuation for each result below cacheSize is created on first use and reused afterwards,
+    * so steady-state parsing does not construct new parsers. Larger results are passed to function every time.
+    */
+    template<typename T, typename F>
+    [[nodiscard]]
+    inline auto BindCached(const Parser<T>& parser, const F& function, size_t cacheSize = 256)
+    {
+        static_assert(std::is_integral_v<T> || std::is_enum_v<T>, "BindCached requires an integral or enumeration result.");
+        using Continuation = decltype(function(ParseResult<T>().GetResult()));
+        using ReturnType = typename Continuation::ReturnType;
+
+        struct Cache
+        {
+            std::vector<std::optional<Continuation>> continuations;
+            std::unique_ptr<std::once_flag[]> created;
+        };
+        auto cache = std::make_shared<Cache>();
+        cache->continuations.resize(cacheSize);
+        cache->created = std::make_unique<std::once_flag[]>(cacheSize);
+
+        Parser<ReturnType> p = [=](const StringState& state, const std::string& string)
+        {
+            auto result = parser(string, state.position);
+            if (!result.Success())
+                return Fail<ReturnType>(state.position);
+            T& value = result.GetResult();
+            using Underlying = typename std::conditional_t<std::is_enum_v<T>,
+                std::underlying_type<T>, std::type_identity<T>>::type;
+            auto raw = static_cast<Underlying>(value);
+            bool cached = static_cast<std::uint64_t>(raw) < cacheSize;
+            if constexpr (std::is_signed_v<Underlying>)
+                cached = cached && raw >= 0;
+
+            ParseResult<ReturnType> continuation;
+            if (cached)
+            {
+                size_t index = static_cast<size_t>(raw);
+                std::call_once(cache->created[index], [&]()
+                {
+                    cache->continuations[index].emplace(function(value));
+                });
+                continuation = (*cache->continuations[index])(string, result.GetPosition());
+            }
+            else
+                continuation = function(value)(string, result.GetPosition());
+            if (continuation.Success())
+                return continuation;
+            return Fail<ReturnType>(state.position);
+        };
+        return p;
+    }
+
     [[nodiscard]]
     Parser<char> Char(char character);
 
@@ -282,7 +403,7 @@ namespace prs
             std::vector<T> results;
             while (true)
             {
-                if (position == string.length())
+                if (position == static_cast<int>(string.length()))
                     break;
                 auto tempResult = parser(string, position);
                 if (tempResult.Success())
@@ -301,12 +422,13 @@ namespace prs
     [[nodiscard]]
     inline Parser<std::vector<T>> AtLeast(uint32_t count, const Parser<T>& parser)
     {
+        auto many = Many(parser);
         return[=](const StringState& state, const std::string& string)
         {
-            auto matches = Many(parser)(string, state.position);
-            const auto& result = matches.GetResult();
+            auto matches = many(string, state.position);
+            auto& result = matches.GetResult();
             if (result.size() >= count)
-                return Success(matches.GetPosition(), result);
+                return Success(matches.GetPosition(), std::move(result));
             return Fail<std::vector<T>>(state.position);
         };
     }
@@ -315,26 +437,219 @@ namespace prs
     [[nodiscard]]
     inline Parser<std::vector<T>> AtLeastOne(const Parser<T>& parser)
     {
-        return[=](const StringState& state, const std::string& string)
-        {
-            return AtLeast(parser, 1)(string, state.position);
-        };
+        return AtLeast(1, parser);
     }
 
     template<typename T>
     [[nodiscard]]
     inline Parser<std::vector<T>> Between(uint32_t min, uint32_t max, const Parser<T>& parser)
     {
+        auto many = Many(parser);
         return[=](const StringState& state, const std::string& string)
         {
-            auto matches = Many(parser)(string, state.position);
-            const auto& result = matches.GetResult();
+            auto matches = many(string, state.position);
+            auto& result = matches.GetResult();
             if (result.size() >= min && result.size() <= max)
-                return Success(matches.GetPosition(), result);
+                return Success(matches.GetPosition(), std::move(result));
             return Fail<std::vector<T>>(state.position);
         };
     }
 
+    namespace detail
+    {
+        /*
+        * Applies parser as many times as possible with separator between the applications, passing each result to accumulate.
+        * When trailing is set, a separator after the last result is consumed as well.
+        * Returns the position after the last result and the number of results.
+        */
+        template<typename T, typename S, typename A>
+        inline std::pair<int, size_t> Separated(const Parser<T>& parser, const Parser<S>& separator,
+            bool trailing, const std::string& string, int position, A&& accumulate)
+        {
+            auto first = parser(string, position);
+            if (!first.Success())
+                return { position, 0 };
+            accumulate(std::move(first.GetResult()));
+            position = first.GetPosition();
+            size_t count = 1;
+            while (true)
+            {
+                auto separatorResult = separator(string, position);
+                if (!separatorResult.Success())
+                    break;
+                auto result = parser(string, separatorResult.GetPosition());
+                if (!result.Success())
+                {
+                    if (trailing)
+                        position = separatorResult.GetPosition();
+                    break;
+                }
+                accumulate(std::move(result.GetResult()));
+                position = result.GetPosition();
+                ++count;
+            }
+            return { position, count };
+        }
+
+        template<typename T, typename S>
+        inline Parser<std::vector<T>> SeparatedList(const Parser<T>& parser, const Parser<S>& separator, bool trailing, size_t minimum)
+        {
+            return [=](const StringState& state, const std::string& string)
+            {
+                std::vector<T> results;
+                auto [position, count] = Separated(parser, separator, trailing, string, state.position, [&](T&& result)
+                {
+                    results.push_back(std::move(result));
+                });
+                if (count < minimum)
+                    return Fail<std::vector<T>>(state.position);
+                return Success(position, std::move(results));
+            };
+        }
+
+        template<typename T, typename S, typename U, typename F>
+        inline Parser<U> SeparatedFold(const Parser<T>& parser, const Parser<S>& separator, bool trailing,
+            const U& initial, const F& folder)
+        {
+            return [=](const StringState& state, const std::string& string)
+            {
+                U accumulator = initial;
+                auto [position, count] = Separated(parser, separator, trailing, string, state.position, [&](T&& result)
+                {
+                    accumulator = folder(std::move(accumulator), std::move(result));
+                });
+                return Success(position, std::move(accumulator));
+            };
+        }
+    }
+
+    /*
+    * Returns a parser for zero or more occurrences of parser separated by separator.
+    */
+    template<typename T, typename S>
+    [[nodiscard]]
+    inline Parser<std::vector<T>> SepBy(const Parser<T>& parser, const Parser<S>& separator)
+    {
+        return detail::SeparatedList(parser, separator, false, 0);
+    }
+
+    /*
+    * Returns a parser for one or more occurrences of parser separated by separator.
+    */
+    template<typename T, typename S>
+    [[nodiscard]]
+    inline Parser<std::vector<T>> SepBy1(const Parser<T>& parser, const Parser<S>& separator)
+    {
+        return detail::SeparatedList(parser, separator, false, 1);
+    }
+
+    /*
+    * Returns a parser for zero or more occurrences of parser separated and optionally ended by separator.
+    */
+    template<typename T, typename S>
+    [[nodiscard]]
+    inline Parser<std::vector<T>> SepEndBy(const Parser<T>& parser, const Parser<S>& separator)
+    {
+        return detail::SeparatedList(parser, separator, true, 0);
+    }
+
+    /*
+    * Returns a parser for one or more occurrences of parser separated and optionally ended by separator.
+    */
+    template<typename T, typename S>
+    [[nodiscard]]
+    inline Parser<std::vector<T>> SepEndBy1(const Parser<T>& parser, const Parser<S>& separator)
+    {
+        return detail::SeparatedList(parser, separator, true, 1);
+    }
+
+    /*
+    * Like SepBy, but folds the results into an accumulator as they are parsed instead of collecting them in a vector.
+    * The folder is called as folder(accumulator, result) and returns the new accumulator.
+    */
+    template<typename T, typename S, typename U, typename F>
+    [[nodiscard]]
+    inline Parser<U> SepBy(const Parser<T>& parser, const Parser<S>& separator, const U& initial, const F& folder)
+    {
+        return detail::SeparatedFold(parser, separator, false, initial, folder);
+    }
+
+    /*
+    * Like SepEndBy, but folds the results into an accumulator as they are parsed instead of collecting them in a vector.
+    */
+    template<typename T, typename S, typename U, typename F>
+    [[nodiscard]]
+    inline Parser<U> SepEndBy(const Parser<T>& parser, const Parser<S>& separator, const U& initial, const F& folder)
+    {
+        return detail::SeparatedFold(parser, separator, true, initial, folder);
+    }
+
+    /*
+    * Returns a parser for one or more terms separated by operators, combined from left to right as they are parsed.
+    * The operator parser returns a function that combines the left and right operands, so a - b - c yields (a - b) - c.
+    */
+    template<typename T, typename F>
+    [[nodiscard]]
+    inline Parser<T> ChainL1(const Parser<T>& term, const Parser<F>& op)
+    {
+        return [=](const StringState& state, const std::string& string)
+        {
+            auto first = term(string, state.position);
+            if (!first.Success())
+                return Fail<T>(state.position);
+            T accumulator = std::move(first.GetResult());
+            int position = first.GetPosition();
+            while (true)
+            {
+                auto opResult = op(string, position);
+                if (!opResult.Success())
+                    break;
+                auto right = term(string, opResult.GetPosition());
+                if (!right.Success())
+                    break;
+                accumulator = opResult.GetResult()(std::move(accumulator), std::move(right.GetResult()));
+                position = right.GetPosition();
+            }
+            return Success(position, std::move(accumulator));
+        };
+    }
+
+    /*
+    * Returns a parser for one or more terms separated by operators, combined from right to left, so a ^ b ^ c yields a ^ (b ^ c).
+    * The operands are kept on an explicit stack rather than through recursion, so long chains cannot overflow the call stack.
+    */
+    template<typename T, typename F>
+    [[nodiscard]]
+    inline Parser<T> ChainR1(const Parser<T>& term, const Parser<F>& op)
+    {
+        return [=](const StringState& state, const std::string& string)
+        {
+            auto first = term(string, state.position);
+            if (!first.Success())
+                return Fail<T>(state.position);
+            std::vector<T> operands;
+            std::vector<F> operators;
+            operands.push_back(std::move(first.GetResult()));
+            int position = first.GetPosition();
+            while (true)
+            {
+                auto opResult = op(string, position);
+                if (!opResult.Success())
+                    break;
+                auto right = term(string, opResult.GetPosition());
+                if (!right.Success())
+                    break;
+                operators.push_back(std::move(opResult.GetResult()));
+                operands.push_back(std::move(right.GetResult()));
+                position = right.GetPosition();
+            }
+            T accumulator = std::move(operands.back());
+            for (size_t i = operators.size(); i > 0; --i)
+                accumulator = operators[i - 1](std::move(operands[i - 1]), std::move(accumulator));
+            return Success(position, std::move(accumulator));
+        };
+    }
+
     template<typename T>
     [[nodiscard]]
     inline auto AnyOf(const std::initializer_list<Parser<T>>& parsers)
@@ -342,7 +657,7 @@ namespace prs
         std::vector<Parser<T>> p = parsers;
         Parser<T> parser = [=](const StringState& state, const std::string& string)
         {
-            if (state.position < string.length())
+            if (state.position < static_cast<int>(string.length()))
                 for (size_t i = 0; i < p.size(); ++i)
                 {
                     auto result = p[i](string, state.position);
@@ -0,0 +1,41 @@
+#include "PerfectHash.h"
+#include <stdexcept>
+
+namespace prs
+{
+    PerfectHash::PerfectHash(std::vector<std::string> keys, bool ignoreCase)
+        : keys(std::move(keys)), ignoreCase(ignoreCase)
+    {
+        if (this->keys.empty())
+            return;
+        size_t size = 1;
+        while (size < this->keys.size() * 2)
+            size *= 2;
+        while (true)
+        {
+            for (std::uint32_t candidate = 0; candidate < 1000; ++candidate)
+            {
+                slots.assign(size, -1);
+                mask = static_cast<std::uint32_t>(size - 1);
+                bool collision = false;
+                for (size_t i = 0; i < this->keys.size() && !collision; ++i)
+                {
+                    std::int32_t& slot = slots[Hash(this->keys[i], candidate, ignoreCase) & mask];
+                    if (slot >= 0)
+                    {
+                        if (ignoreCase ? EqualIgnoringCase(this->keys[slot], this->keys[i]) : this->keys[slot] == this->keys[i])
+                            throw std::invalid_argument("The keys of a perfect hash must be distinct.");
+                        collision = true;
+                    }
+                    slot = static_cast<std::int32_t>(i);
+                }
+                if (!collision)
+                {
+                    seed = candidate;
+                    return;
+                }
+            }
+            size *= 2;
+        }
+    }
+}
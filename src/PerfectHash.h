@@ -0,0 +1,108 @@
+#ifndef PERFECT_HASH_H
+#define PERFECT_HASH_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include "Swar.h"
+
+namespace prs
+{
+    /*
+    * A collision-free hash table over a fixed set of keys, built once at construction.
+    * A seed is searched for that maps every key to its own slot, so a lookup is one hash and one comparison.
+    */
+    class PerfectHash
+    {
+    private:
+        std::vector<std::string> keys;
+        std::vector<std::int32_t> slots;
+        std::uint32_t seed = 0;
+        std::uint32_t mask = 0;
+        bool ignoreCase = false;
+
+        /*
+        * Packs a key of fewer than eight characters into a word without reading past it.
+        * Overlapping reads are enough to tell two keys of the same length apart.
+        */
+        static std::uint64_t ShortWord(const char* key, size_t length)
+        {
+            if (length >= 4)
+            {
+                std::uint32_t first, last;
+                std::memcpy(&first, key, sizeof(first));
+                std::memcpy(&last, key + length - 4, sizeof(last));
+                return first | static_cast<std::uint64_t>(last) << 32;
+            }
+            if (length == 0)
+                return 0;
+            return static_cast<unsigned char>(key[0]) | static_cast<unsigned char>(key[length / 2]) << 8 |
+                static_cast<std::uint64_t>(static_cast<unsigned char>(key[length - 1])) << 16;
+        }
+
+        static std::uint64_t Mix(std::uint64_t hash, std::uint64_t word, bool ignoreCase)
+        {
+            hash = (hash ^ (ignoreCase ? swar::ToLower(word) : word)) * 0xBF58476D1CE4E5B9ull;
+            return hash ^ (hash >> 31);
+        }
+
+        /*
+        * Hashes eight characters at a time. The last word of a key of eight or more characters overlaps the one before it.
+        */
+        static std::uint32_t Hash(std::string_view key, std::uint32_t seed, bool ignoreCase)
+        {
+            const char* data = key.data();
+            size_t length = key.length();
+            std::uint64_t hash = (seed + 1) * 0x9E3779B97F4A7C15ull ^ length;
+            if (length < 8)
+                hash = Mix(hash, ShortWord(data, length), ignoreCase);
+            else
+            {
+                for (size_t offset = 0; offset + 8 < length; offset += 8)
+                    hash = Mix(hash, swar::Load(data + offset), ignoreCase);
+                hash = Mix(hash, swar::Load(data + length - 8), ignoreCase);
+            }
+            return static_cast<std::uint32_t>(hash ^ (hash >> 32));
+        }
+
+        static bool EqualIgnoringCase(std::string_view a, std::string_view b)
+        {
+            size_t length = a.length();
+            if (length != b.length())
+                return false;
+            if (length < 8)
+                return swar::ToLower(ShortWord(a.data(), length)) == swar::ToLower(ShortWord(b.data(), length));
+            for (size_t offset = 0; offset + 8 < length; offset += 8)
+                if (swar::ToLower(swar::Load(a.data() + offset)) != swar::ToLower(swar::Load(b.data() + offset)))
+                    return false;
+            return swar::ToLower(swar::Load(a.data() + length - 8)) == swar::ToLower(swar::Load(b.data() + length - 8));
+        }
+    public:
+        PerfectHash() { }
+
+        /*
+        * Builds the table. Keys must be distinct.
+        * When ignoreCase is true, ASCII letters match regardless of case, and keys must also differ in more than case.
+        */
+        explicit PerfectHash(std::vector<std::string> keys, bool ignoreCase = false);
+
+        /*
+        * Returns the index of a key in the vector passed to the constructor, or -1 if it is not one of the keys.
+        */
+        int Find(std::string_view key) const
+        {
+            if (slots.empty())
+                return -1;
+            std::int32_t index = slots[Hash(key, seed, ignoreCase) & mask];
+            if (index < 0)
+                return -1;
+            if (ignoreCase ? !EqualIgnoringCase(keys[index], key) : keys[index] != key)
+                return -1;
+            return index;
+        }
+    };
+}
+
+#endif
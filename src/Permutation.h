@@ -0,0 +1,135 @@
+#ifndef PERMUTATION_H
+#define PERMUTATION_H
+
+#include <string>
+#include <vector>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <initializer_list>
+#include "Parser.h"
+
+namespace prs
+{
+    /*
+    * A keyed field of a permutation, which parses the value following its key into a member of S.
+    */
+    template<typename S>
+    struct PermutationField
+    {
+        std::string key;
+        bool required;
+        std::function<ParseResult<Void>(S&, const std::string&, int)> parse;
+    };
+
+    /*
+    * Returns a field that must appear exactly once. The value parser runs directly after the key.
+    */
+    template<typename S, typename T, typename M>
+    [[nodiscard]]
+    inline PermutationField<S> Required(const std::string& key, const Parser<T>& value, M S::* member)
+    {
+        auto parse = [value, member](S& result, const std::string& string, int position)
+        {
+            auto valueResult = value(string, position);
+            if (!valueResult.Success())
+                return Fail<Void>(position);
+            result.*member = std::move(valueResult.GetResult());
+            return Success(valueResult.GetPosition(), Void());
+        };
+        return PermutationField<S>{ key, true, parse };
+    }
+
+    /*
+    * Returns a field that may appear at most once. The member keeps its default value when the field is absent.
+    */
+    template<typename S, typename T, typename M>
+    [[nodiscard]]
+    inline PermutationField<S> Optional(const std::string& key, const Parser<T>& value, M S::* member)
+    {
+        auto field = Required(key, value, member);
+        field.required = false;
+        return field;
+    }
+
+    /*
+    * Returns a parser for keyed fields in any order, separated by a separator, which builds an S directly.
+    * The field is selected by the first character of the key, trying longer keys first, and the fields seen so far are tracked in a bitmask,
+    * so parsing is linear in the number of fields. The parser fails on a repeated field or when a required field is missing.
+    * At most 64 fields are supported.
+    */
+    template<typename S>
+    [[nodiscard]]
+    inline Parser<S> Permutation(const Parser<Void>& separator, std::initializer_list<PermutationField<S>> fields)
+    {
+        std::vector<PermutationField<S>> f = fields;
+        if (f.size() > 64)
+            throw std::invalid_argument("A permutation supports at most 64 fields.");
+
+        std::uint64_t requiredMask = 0;
+        std::array<std::vector<std::uint8_t>, 256> candidates;
+        for (size_t i = 0; i < f.size(); ++i)
+        {
+            if (f[i].key.empty())
+                throw std::invalid_argument("The key of a permutation field must not be empty.");
+            if (f[i].required)
+                requiredMask |= std::uint64_t(1) << i;
+            candidates[static_cast<unsigned char>(f[i].key[0])].push_back(static_cast<std::uint8_t>(i));
+        }
+        for (auto& list : candidates)
+            std::stable_sort(list.begin(), list.end(), [&](std::uint8_t a, std::uint8_t b)
+            {
+                return f[a].key.length() > f[b].key.length();
+            });
+
+        return [=](const StringState& state, const std::string& string)
+        {
+            S result{};
+            std::uint64_t seen = 0;
+            int length = static_cast<int>(string.length());
+            int position = state.position;
+            while (true)
+            {
+                int fieldStart = position;
+                if (seen != 0)
+                {
+                    auto separatorResult = separator(string, position);
+                    if (!separatorResult.Success())
+                        break;
+                    fieldStart = separatorResult.GetPosition();
+                }
+                if (fieldStart >= length)
+                    break;
+
+                bool matched = false;
+                for (std::uint8_t index : candidates[static_cast<unsigned char>(string[fieldStart])])
+                {
+                    const std::string& key = f[index].key;
+                    if (length - fieldStart < static_cast<int>(key.length()) ||
+                        std::memcmp(string.data() + fieldStart, key.data(), key.length()) != 0)
+                        continue;
+                    std::uint64_t bit = std::uint64_t(1) << index;
+                    if (seen & bit)
+                        return Fail<S>(state.position);
+                    auto fieldResult = f[index].parse(result, string, fieldStart + static_cast<int>(key.length()));
+                    if (!fieldResult.Success())
+                        continue;
+                    seen |= bit;
+                    position = fieldResult.GetPosition();
+                    matched = true;
+                    break;
+                }
+                if (!matched)
+                    break;
+            }
+            if ((seen & requiredMask) != requiredMask)
+                return Fail<S>(state.position);
+            return Success(position, std::move(result));
+        };
+    }
+}
+
+#endif
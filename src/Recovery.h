@@ -0,0 +1,114 @@
+#ifndef RECOVERY_H
+#define RECOVERY_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <optional>
+#include <cstring>
+#include "Parser.h"
+
+namespace prs
+{
+    /*
+    * A syntax error that was recovered from: where the failing parser started and where parsing resumed.
+    */
+    struct ParseError
+    {
+        int position;
+        int resumePosition;
+    };
+
+    /*
+    * Collects the errors recovered from during a parse, so one pass can report all of them.
+    */
+    class ErrorLog
+    {
+    private:
+        std::vector<ParseError> errors;
+    public:
+        void Record(const ParseError& error)
+        {
+            errors.push_back(error);
+        }
+
+        const std::vector<ParseError>& Errors() const
+        {
+            return errors;
+        }
+
+        bool Empty() const
+        {
+            return errors.empty();
+        }
+
+        void Clear()
+        {
+            errors.clear();
+        }
+    };
+
+    /*
+    * Returns a parser that runs parser, and when it fails records an error and skips past the next synchronization character,
+    * such as ';' or '\n', or to the end of the input. The result is empty when the parser failed.
+    * Fails without recording an error at the end of the input, where there is nothing left to skip.
+    */
+    template<typename T>
+    [[nodiscard]]
+    inline Parser<std::optional<T>> Recover(const std::shared_ptr<ErrorLog>& errors, const Parser<T>& parser, char synchronization)
+    {
+        return [=](const StringState& state, const std::string& string)
+        {
+            auto result = parser(string, state.position);
+            if (result.Success())
+                return Success(result.GetPosition(), std::optional<T>(std::move(result.GetResult())));
+
+            int length = static_cast<int>(string.length());
+            if (state.position >= length)
+                return Fail<std::optional<T>>(state.position);
+            int position = length;
+            const void* found = std::memchr(string.data() + state.position, synchronization, length - state.position);
+            if (found != nullptr)
+                position = static_cast<int>(static_cast<const char*>(found) - string.data()) + 1;
+            errors->Record({ state.position, position });
+            return Success(position, std::optional<T>());
+        };
+    }
+
+    /*
+    * Returns a parser that runs parser, and when it fails records an error and skips to the first position
+    * where the synchronization parser succeeds, consuming what it matches, or to the end of the input.
+    * A match that would leave the position where the parser failed is ignored, so recovery always consumes input
+    * and repeating it with Many terminates. Fails without recording an error at the end of the input.
+    * The result is empty when the parser failed.
+    */
+    template<typename T, typename S>
+    [[nodiscard]]
+    inline Parser<std::optional<T>> Recover(const std::shared_ptr<ErrorLog>& errors, const Parser<T>& parser, const Parser<S>& synchronization)
+    {
+        return [=](const StringState& state, const std::string& string)
+        {
+            auto result = parser(string, state.position);
+            if (result.Success())
+                return Success(result.GetPosition(), std::optional<T>(std::move(result.GetResult())));
+
+            int length = static_cast<int>(string.length());
+            if (state.position >= length)
+                return Fail<std::optional<T>>(state.position);
+            int position = length;
+            for (int candidate = state.position; candidate < length; ++candidate)
+            {
+                auto synchronized = synchronization(string, candidate);
+                if (synchronized.Success() && synchronized.GetPosition() > state.position)
+                {
+                    position = synchronized.GetPosition();
+                    break;
+                }
+            }
+            errors->Record({ state.position, position });
+            return Success(position, std::optional<T>());
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef SCAN_H
+#define SCAN_H
+
+#include <bit>
+#include "Swar.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PRS_SSE2 1
+#endif
+
+/*
+*
+* Searches for characters sixteen at a time with SSE2 where it is available, and eight at a time otherwise.
+*
+*/
+
+namespace prs::scan
+{
+    /*
+    * Returns a pointer to the first occurrence of a or b in [begin, end), or end if there is none.
+    */
+    inline const char* FindFirstOf(const char* begin, const char* end, char a, char b)
+    {
+#ifdef PRS_SSE2
+        __m128i first = _mm_set1_epi8(a);
+        __m128i second = _mm_set1_epi8(b);
+        for (; end - begin >= 16; begin += 16)
+        {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+            __m128i matches = _mm_or_si128(_mm_cmpeq_epi8(chunk, first), _mm_cmpeq_epi8(chunk, second));
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(matches));
+            if (mask != 0)
+                return begin + std::countr_zero(mask);
+        }
+#endif
+        return swar::FindFirstOf(begin, end, a, b);
+    }
+
+    /*
+    * Returns a pointer to the first character in [begin, end) whose unsigned value is below bound, or end if there is none.
+    * The bound must be between 1 and 128.
+    */
+    inline const char* FindFirstBelow(const char* begin, const char* end, unsigned char bound)
+    {
+#ifdef PRS_SSE2
+        __m128i maximum = _mm_set1_epi8(static_cast<char>(bound - 1));
+        for (; end - begin >= 16; begin += 16)
+        {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+            __m128i below = _mm_cmpeq_epi8(_mm_min_epu8(chunk, maximum), chunk);
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(below));
+            if (mask != 0)
+                return begin + std::countr_zero(mask);
+        }
+#endif
+        return swar::FindFirstBelow(begin, end, bound);
+    }
+
+    /*
+    * Returns a pointer to the first control character in [begin, end), which is a character below ' ' or DEL, or end if there is none.
+    */
+    inline const char* FindFirstControl(const char* begin, const char* end)
+    {
+#ifdef PRS_SSE2
+        __m128i maximum = _mm_set1_epi8(' ' - 1);
+        __m128i del = _mm_set1_epi8(0x7F);
+        for (; end - begin >= 16; begin += 16)
+        {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+            __m128i controls = _mm_or_si128(_mm_cmpeq_epi8(_mm_min_epu8(chunk, maximum), chunk), _mm_cmpeq_epi8(chunk, del));
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(controls));
+            if (mask != 0)
+                return begin + std::countr_zero(mask);
+        }
+#endif
+        return swar::FindFirstControl(begin, end);
+    }
+}
+
+#endif
@@ -0,0 +1,183 @@
+#include "Strings.h"
+#include "Scan.h"
+#include <cstring>
+#include <cstdint>
+
+namespace prs
+{
+    namespace detail
+    {
+        char* AppendUtf8(char* out, std::uint32_t codePoint)
+        {
+            if (codePoint < 0x80)
+                *out++ = static_cast<char>(codePoint);
+            else if (codePoint < 0x800)
+            {
+                *out++ = static_cast<char>(0xC0 | (codePoint >> 6));
+                *out++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+            else if (codePoint < 0x10000)
+            {
+                *out++ = static_cast<char>(0xE0 | (codePoint >> 12));
+                *out++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                *out++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+            else
+            {
+                *out++ = static_cast<char>(0xF0 | (codePoint >> 18));
+                *out++ = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+                *out++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                *out++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+            return out;
+        }
+    }
+
+    namespace
+    {
+        /*
+        * Returns the position of the closing quote of a string whose contents start at begin, or -1 if it is not closed.
+        * Sets escaped when an escape sequence was skipped.
+        */
+        int FindClosingQuote(const char* data, int begin, int length, char quote, char escape, EscapePolicy policy, bool& escaped)
+        {
+            char other = policy == EscapePolicy::DoubledQuote ? quote : escape;
+            int position = begin;
+            while (true)
+            {
+                int index = static_cast<int>(scan::FindFirstOf(data + position, data + length, quote, other) - data);
+                if (index == length)
+                    return -1;
+                if (policy == EscapePolicy::DoubledQuote)
+                {
+                    if (index + 1 < length && data[index + 1] == quote)
+                    {
+                        escaped = true;
+                        position = index + 2;
+                        continue;
+                    }
+                    return index;
+                }
+                if (data[index] == quote)
+                    return index;
+                escaped = true;
+                position = index + 2;
+                if (position > length)
+                    return -1;
+            }
+        }
+
+        bool ParseHex4(const char* p, std::uint32_t& value)
+        {
+            value = 0;
+            for (int i = 0; i < 4; ++i)
+            {
+                char c = p[i];
+                std::uint32_t digit;
+                if (c >= '0' && c <= '9')
+                    digit = c - '0';
+                else if (c >= 'a' && c <= 'f')
+                    digit = c - 'a' + 10;
+                else if (c >= 'A' && c <= 'F')
+                    digit = c - 'A' + 10;
+                else
+                    return false;
+                value = value * 16 + digit;
+            }
+            return true;
+        }
+
+        /*
+        * Decodes the escape sequence following an escape character at p.
+        * Returns the position after the sequence, or nullptr if the sequence is invalid.
+        */
+        const char* UnescapeJson(const char* p, const char* end, char escape, char*& out)
+        {
+            switch (*p)
+            {
+            case '"': *out++ = '"'; return p + 1;
+            case '\\': *out++ = '\\'; return p + 1;
+            case '/': *out++ = '/'; return p + 1;
+            case 'b': *out++ = '\b'; return p + 1;
+            case 'f': *out++ = '\f'; return p + 1;
+            case 'n': *out++ = '\n'; return p + 1;
+            case 'r': *out++ = '\r'; return p + 1;
+            case 't': *out++ = '\t'; return p + 1;
+            case 'u':
+                break;
+            default:
+                return nullptr;
+            }
+
+            std::uint32_t codePoint;
+            if (end - p < 5 || !ParseHex4(p + 1, codePoint))
+                return nullptr;
+            p += 5;
+            if (codePoint >= 0xDC00 && codePoint <= 0xDFFF)
+                return nullptr;
+            if (codePoint >= 0xD800 && codePoint <= 0xDBFF)
+            {
+                std::uint32_t low;
+                if (end - p < 6 || p[0] != escape || p[1] != 'u' || !ParseHex4(p + 2, low) ||
+                    low < 0xDC00 || low > 0xDFFF)
+                    return nullptr;
+                codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                p += 6;
+            }
+            out = detail::AppendUtf8(out, codePoint);
+            return p;
+        }
+
+        /*
+        * Unescapes [p, end) into out, which must have room for end - p characters.
+        * Returns the number of characters written, or -1 if an escape sequence is invalid.
+        */
+        int Unescape(const char* p, const char* end, char* out, char quote, char escape, EscapePolicy policy)
+        {
+            char* begin = out;
+            char special = policy == EscapePolicy::DoubledQuote ? quote : escape;
+            while (true)
+            {
+                const char* next = scan::FindFirstOf(p, end, special, special);
+                std::memcpy(out, p, next - p);
+                out += next - p;
+                if (next == end)
+                    return static_cast<int>(out - begin);
+                p = next + 1;
+                if (policy == EscapePolicy::Json)
+                {
+                    p = UnescapeJson(p, end, escape, out);
+                    if (p == nullptr)
+                        return -1;
+                }
+                else
+                    *out++ = *p++;
+            }
+        }
+    }
+
+    Parser<std::string_view> QuotedString(const std::shared_ptr<Arena>& arena, char quote, char escape, EscapePolicy policy)
+    {
+        return [=](const StringState& state, const std::string& string)
+        {
+            const char* data = string.data();
+            int length = static_cast<int>(string.length());
+            if (state.position >= length || data[state.position] != quote)
+                return Fail<std::string_view>(state.position);
+
+            int begin = state.position + 1;
+            bool escaped = false;
+            int end = FindClosingQuote(data, begin, length, quote, escape, policy, escaped);
+            if (end < 0)
+                return Fail<std::string_view>(state.position);
+            if (!escaped)
+                return Success(end + 1, std::string_view(data + begin, end - begin));
+
+            char* out = static_cast<char*>(arena->Allocate(end - begin, 1));
+            int count = Unescape(data + begin, data + end, out, quote, escape, policy);
+            if (count < 0)
+                return Fail<std::string_view>(state.position);
+            return Success(end + 1, std::string_view(out, count));
+        };
+    }
+}
@@ -0,0 +1,51 @@
+#ifndef STRINGS_H
+#define STRINGS_H
+
+#include <string>
+#include <string_view>
+#include <memory>
+#include <cstdint>
+#include "Parser.h"
+#include "Arena.h"
+
+namespace prs
+{
+    namespace detail
+    {
+        /*
+        * Writes the UTF-8 encoding of a code point, which takes at most four characters, and returns the position after it.
+        */
+        char* AppendUtf8(char* out, std::uint32_t codePoint);
+    }
+
+    /*
+    * The escape sequences understood by QuotedString.
+    */
+    enum class EscapePolicy
+    {
+        /*
+        * The escape sequences of JSON: \" \\ \/ \b \f \n \r \t and \uXXXX, including surrogate pairs, which are converted to UTF-8.
+        */
+        Json,
+        /*
+        * The escape character followed by any character stands for that character.
+        */
+        Verbatim,
+        /*
+        * Two quotes in a row stand for one quote, as in CSV. The escape character is not used.
+        */
+        DoubledQuote
+    };
+
+    /*
+    * Returns a parser for a quoted string, which returns the characters between the quotes.
+    * The closing quote is found sixteen characters at a time. Strings without escape sequences are returned as a view into the input,
+    * while strings with escape sequences are unescaped into the arena.
+    * Control characters inside the quotes are not rejected.
+    */
+    [[nodiscard]]
+    Parser<std::string_view> QuotedString(const std::shared_ptr<Arena>& arena,
+        char quote = '"', char escape = '\\', EscapePolicy policy = EscapePolicy::Json);
+}
+
+#endif
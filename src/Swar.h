@@ -0,0 +1,210 @@
+#ifndef SWAR_H
+#define SWAR_H
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <climits>
+
+/*
+*
+* Helpers that process eight characters at a time in a 64-bit integer ("SIMD within a register").
+* Big-endian targets fall back to processing one character at a time.
+*
+*/
+
+namespace prs::swar
+{
+    constexpr bool enabled = std::endian::native == std::endian::little;
+
+    constexpr std::uint64_t ones = 0x0101010101010101ull;
+    constexpr std::uint64_t highBits = 0x8080808080808080ull;
+
+    inline std::uint64_t Load(const char* pointer)
+    {
+        std::uint64_t word;
+        std::memcpy(&word, pointer, sizeof(word));
+        return word;
+    }
+
+    /*
+    * Converts the ASCII uppercase letters among the bytes of a word to lowercase and leaves the other bytes unchanged.
+    */
+    inline std::uint64_t ToLower(std::uint64_t word)
+    {
+        std::uint64_t ascii = word & ~highBits;
+        std::uint64_t atLeastA = ascii + ones * (0x80 - 'A');
+        std::uint64_t afterZ = ascii + ones * (0x80 - 'Z' - 1);
+        std::uint64_t upper = atLeastA & ~afterZ & ~word & highBits;
+        return word | (upper >> 2);
+    }
+
+    /*
+    * Returns a word whose highest set byte bit marks the first byte of the argument that is equal to character.
+    * Bytes after the first match may be marked as well.
+    */
+    inline std::uint64_t Match(std::uint64_t word, char character)
+    {
+        std::uint64_t x = word ^ (ones * static_cast<unsigned char>(character));
+        return (x - ones) & ~x & highBits;
+    }
+
+    /*
+    * Returns a pointer to the first occurrence of a or b in [begin, end), or end if there is none.
+    */
+    inline const char* FindFirstOf(const char* begin, const char* end, char a, char b)
+    {
+        if constexpr (enabled)
+        {
+            for (; end - begin >= 8; begin += 8)
+            {
+                std::uint64_t word = Load(begin);
+                std::uint64_t matches = Match(word, a) | Match(word, b);
+                if (matches != 0)
+                    return begin + std::countr_zero(matches) / 8;
+            }
+        }
+        for (; begin != end; ++begin)
+            if (*begin == a || *begin == b)
+                return begin;
+        return end;
+    }
+
+    /*
+    * Returns a pointer to the first character in [begin, end) whose unsigned value is below bound, or end if there is none.
+    * The bound must be at most 128.
+    */
+    inline const char* FindFirstBelow(const char* begin, const char* end, unsigned char bound)
+    {
+        if constexpr (enabled)
+        {
+            for (; end - begin >= 8; begin += 8)
+            {
+                std::uint64_t word = Load(begin);
+                std::uint64_t matches = (word - ones * bound) & ~word & highBits;
+                if (matches != 0)
+                    return begin + std::countr_zero(matches) / 8;
+            }
+        }
+        for (; begin != end; ++begin)
+            if (static_cast<unsigned char>(*begin) < bound)
+                return begin;
+        return end;
+    }
+
+    /*
+    * Returns a pointer to the first control character in [begin, end), which is a character below ' ' or DEL, or end if there is none.
+    */
+    inline const char* FindFirstControl(const char* begin, const char* end)
+    {
+        if constexpr (enabled)
+        {
+            for (; end - begin >= 8; begin += 8)
+            {
+                std::uint64_t word = Load(begin);
+                std::uint64_t matches = ((word - ones * ' ') & ~word & highBits) | Match(word, 0x7F);
+                if (matches != 0)
+                    return begin + std::countr_zero(matches) / 8;
+            }
+        }
+        for (; begin != end; ++begin)
+            if (static_cast<unsigned char>(*begin) < ' ' || *begin == 0x7F)
+                return begin;
+        return end;
+    }
+
+    /*
+    * Returns whether all eight bytes of a word are ASCII digits.
+    */
+    inline bool IsEightDigits(std::uint64_t word)
+    {
+        return ((word & 0xF0F0F0F0F0F0F0F0ull) |
+            (((word + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) == 0x3333333333333333ull;
+    }
+
+    /*
+    * Returns the value of a word of eight ASCII digits, the first digit being the most significant.
+    */
+    inline std::uint32_t ParseEightDigits(std::uint64_t word)
+    {
+        constexpr std::uint64_t mask = 0x000000FF000000FFull;
+        constexpr std::uint64_t multiplier1 = 100 + (1000000ull << 32);
+        constexpr std::uint64_t multiplier2 = 1 + (10000ull << 32);
+        word -= 0x3030303030303030ull;
+        word = (word * 10) + (word >> 8);
+        word = (((word & mask) * multiplier1) + (((word >> 16) & mask) * multiplier2)) >> 32;
+        return static_cast<std::uint32_t>(word);
+    }
+
+    /*
+    * Converts up to 19 ASCII digits, failing if any character is not a digit.
+    * The characters up to limit may be read, which avoids copying a final group of fewer than eight digits.
+    */
+    inline bool ParseDigits(const char* digits, int count, const char* limit, std::uint64_t& value)
+    {
+        value = 0;
+        if constexpr (enabled)
+        {
+            constexpr std::uint64_t powers[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000 };
+            constexpr std::uint64_t zeros = 0x3030303030303030ull;
+            int i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                std::uint64_t word = Load(digits + i);
+                if (!IsEightDigits(word))
+                    return false;
+                value = value * 100000000 + ParseEightDigits(word);
+            }
+            int remaining = count - i;
+            if (remaining > 0)
+            {
+                std::uint64_t word;
+                if (limit - (digits + i) >= 8)
+                    word = (Load(digits + i) << (8 * (8 - remaining))) | (zeros >> (8 * remaining));
+                else
+                {
+                    char buffer[8];
+                    std::memset(buffer, '0', sizeof(buffer));
+                    std::memcpy(buffer + 8 - remaining, digits + i, remaining);
+                    word = Load(buffer);
+                }
+                if (!IsEightDigits(word))
+                    return false;
+                value = value * powers[remaining] + ParseEightDigits(word);
+            }
+            return true;
+        }
+        for (int i = 0; i < count; ++i)
+        {
+            if (digits[i] < '0' || digits[i] > '9')
+                return false;
+            value = value * 10 + (digits[i] - '0');
+        }
+        return true;
+    }
+
+    /*
+    * Converts an integer with the syntax accepted by prs::integer that fits in 64 bits.
+    * The characters up to limit may be read.
+    */
+    inline bool ParseInteger(const char* text, int count, const char* limit, std::int64_t& value)
+    {
+        bool negative = count > 0 && text[0] == '-';
+        if (negative)
+        {
+            ++text;
+            --count;
+        }
+        if (count == 0 || count > 19 || (count > 1 && text[0] == '0'))
+            return false;
+        std::uint64_t magnitude;
+        if (!ParseDigits(text, count, limit, magnitude))
+            return false;
+        if (magnitude > static_cast<std::uint64_t>(INT64_MAX) + (negative ? 1 : 0))
+            return false;
+        value = static_cast<std::int64_t>(negative ? 0 - magnitude : magnitude);
+        return true;
+    }
+}
+
+#endif
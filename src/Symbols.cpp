@@ -0,0 +1,109 @@
+#include "Symbols.h"
+
+namespace prs
+{
+    namespace
+    {
+        std::uint32_t Hash(std::string_view name)
+        {
+            std::uint32_t hash = 2166136261u;
+            for (char c : name)
+            {
+                hash ^= static_cast<unsigned char>(c);
+                hash *= 16777619u;
+            }
+            return hash;
+        }
+
+        bool IsLetter(char c)
+        {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+        }
+
+        bool IsAlphanumeric(char c)
+        {
+            return IsLetter(c) || (c >= '0' && c <= '9');
+        }
+    }
+
+    SymbolTable::SymbolTable()
+        : slots(64, Slot{ 0, empty }) { }
+
+    void SymbolTable::Grow()
+    {
+        std::vector<Slot> old(slots.size() * 2, Slot{ 0, empty });
+        old.swap(slots);
+        size_t mask = slots.size() - 1;
+        for (const Slot& slot : old)
+        {
+            if (slot.symbol == empty)
+                continue;
+            size_t index = slot.hash & mask;
+            while (slots[index].symbol != empty)
+                index = (index + 1) & mask;
+            slots[index] = slot;
+        }
+    }
+
+    Symbol SymbolTable::Intern(std::string_view name)
+    {
+        std::uint32_t hash = Hash(name);
+        size_t mask = slots.size() - 1;
+        size_t index = hash & mask;
+        while (slots[index].symbol != empty)
+        {
+            const Slot& slot = slots[index];
+            if (slot.hash == hash && names[slot.symbol] == name)
+                return slot.symbol;
+            index = (index + 1) & mask;
+        }
+
+        Symbol symbol = static_cast<Symbol>(names.size());
+        names.push_back(storage.emplace_back(name));
+        slots[index] = Slot{ hash, symbol };
+        if (names.size() * 2 > slots.size())
+            Grow();
+        return symbol;
+    }
+
+    std::optional<Symbol> SymbolTable::Find(std::string_view name) const
+    {
+        std::uint32_t hash = Hash(name);
+        size_t mask = slots.size() - 1;
+        size_t index = hash & mask;
+        while (slots[index].symbol != empty)
+        {
+            const Slot& slot = slots[index];
+            if (slot.hash == hash && names[slot.symbol] == name)
+                return slot.symbol;
+            index = (index + 1) & mask;
+        }
+        return std::nullopt;
+    }
+
+    std::string_view SymbolTable::Name(Symbol symbol) const
+    {
+        return names[symbol];
+    }
+
+    size_t SymbolTable::Size() const
+    {
+        return names.size();
+    }
+
+    Parser<Symbol> Identifier(const std::shared_ptr<SymbolTable>& symbols)
+    {
+        return [symbols](const StringState& state, const std::string& string)
+        {
+            int length = static_cast<int>(string.length());
+            int position = state.position;
+            if (position >= length || !IsLetter(string[position]))
+                return Fail<Symbol>(state.position);
+            ++position;
+            while (position < length && IsAlphanumeric(string[position]))
+                ++position;
+            std::string_view name(string.data() + state.position, position - state.position);
+            return Success(position, symbols->Intern(name));
+        };
+    }
+}
@@ -0,0 +1,71 @@
+#ifndef SYMBOLS_H
+#define SYMBOLS_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <cstdint>
+#include "Parser.h"
+
+namespace prs
+{
+    /*
+    * A stable 32-bit id of an interned name.
+    */
+    using Symbol = std::uint32_t;
+
+    /*
+    * An open-addressing hash table mapping names to symbols.
+    * Symbols are numbered consecutively from 0 in the order the names are first interned,
+    * and stay valid for the lifetime of the table, so a table can be shared by several parses.
+    * A table is not safe to use from several threads at the same time.
+    */
+    class SymbolTable
+    {
+    private:
+        struct Slot
+        {
+            std::uint32_t hash;
+            Symbol symbol;
+        };
+
+        static constexpr Symbol empty = UINT32_MAX;
+
+        std::vector<Slot> slots;
+        std::deque<std::string> storage;
+        std::vector<std::string_view> names;
+
+        void Grow();
+    public:
+        SymbolTable();
+
+        /*
+        * Returns the symbol of a name, adding the name to the table if it is not already present.
+        */
+        Symbol Intern(std::string_view name);
+
+        /*
+        * Returns the symbol of a name if it has been interned.
+        */
+        std::optional<Symbol> Find(std::string_view name) const;
+
+        /*
+        * Returns the name of a symbol.
+        */
+        std::string_view Name(Symbol symbol) const;
+
+        size_t Size() const;
+    };
+
+    /*
+    * Returns a parser for a letter followed by any number of letters and digits,
+    * which returns the symbol of the matched name instead of a copy of it.
+    */
+    [[nodiscard]]
+    Parser<Symbol> Identifier(const std::shared_ptr<SymbolTable>& symbols);
+}
+
+#endif
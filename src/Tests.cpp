@@ -0,0 +1,1322 @@
+#include <string>
+#include <vector>
+#include <memory>
+#include <random>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <iostream>
+#include <source_location>
+#include <functional>
+#include <thread>
+#include <limits>
+#include <cmath>
+#include "Parser.h"
+#include "Indentation.h"
+#include "Symbols.h"
+#include "ParseEach.h"
+#include "OnDemand.h"
+#include "Columns.h"
+#include "Numeric.h"
+#include "Timestamps.h"
+#include "Strings.h"
+#include "Encoding.h"
+#include "Fields.h"
+#include "FixedWidth.h"
+#include "Permutation.h"
+#include "KeyDispatch.h"
+#include "Coroutine.h"
+#include "Recovery.h"
+#include "Expectations.h"
+#include "Interruptible.h"
+#include "ParallelChoice.h"
+#include "Json.h"
+#include "Csv.h"
+#include "Http.h"
+#include "Logs.h"
+#include "Xml.h"
+
+/*
+* Checks the behavior of the library at the edges of its inputs. Like the benchmarks, this is a standalone program with its own main.
+* Every failed check is printed with its line, and the program fails if any check did.
+*/
+
+namespace
+{
+    int failures = 0;
+
+    void Check(bool condition, std::source_location location = std::source_location::current())
+    {
+        if (!condition)
+        {
+            std::cerr << location.file_name() << ":" << location.line() << ": check failed\n";
+            ++failures;
+        }
+    }
+
+    void TestIndentation()
+    {
+        using namespace prs;
+
+        auto indentation = std::make_shared<Indentation>();
+        Parser<std::string> line = letters >> ~Char('\n');
+        auto block = Block(indentation, line);
+
+        std::string flat = "a\nb\nc\n";
+        auto result = block(flat);
+        Check(result.Success() && result.GetResult().size() == 3 && result.GetPosition() == 6);
+
+        std::string blankLines = "  a\n\n   \n  b\n";
+        result = block(blankLines);
+        Check(result.Success() && result.GetResult().size() == 2 && result.GetResult()[1] == "b");
+
+        std::string dedent = "  a\n  b\n c\n";
+        result = block(dedent);
+        Check(result.Success() && result.GetResult().size() == 2 && result.GetPosition() == 8);
+
+        std::string empty = "\n  \n";
+        Check(!block(empty).Success());
+
+        std::string notLineStart = "x a\n";
+        Check(!block(notLineStart, 2).Success());
+
+        Parser<Pair<std::string, std::vector<std::string>>> section = line >> Block(indentation, line);
+        std::string nested = "a\n  b\n  c\nd\n";
+        auto sections = Block(indentation, section)(nested);
+        Check(sections.Success() && sections.GetResult().size() == 1 && sections.GetPosition() == 10);
+        auto withChildren = Block(indentation, section || (line | [](const std::string& name)
+        {
+            return Pair<std::string, std::vector<std::string>>{ name, {} };
+        }))(nested);
+        Check(withChildren.Success() && withChildren.GetResult().size() == 2 &&
+            withChildren.GetResult()[0].second.size() == 2 && withChildren.GetPosition() == static_cast<int>(nested.length()));
+
+        std::string shallow = "a\nb\n";
+        Check(!Block(indentation, section)(shallow).Success());
+
+        std::string sameLine = "  x\ny";
+        Check(SameLine(whitespaces)(sameLine).Success());
+        Check(!SameLine(whitespaces >> letters)(sameLine, 3).Success());
+    }
+
+    void TestSymbols()
+    {
+        using namespace prs;
+
+        auto symbols = std::make_shared<SymbolTable>();
+        Symbol first = symbols->Intern("alpha");
+        std::string_view firstName = symbols->Name(first);
+        Check(first == 0 && symbols->Intern("beta") == 1 && symbols->Intern("alpha") == first);
+        Check(!symbols->Find("gamma").has_value() && symbols->Find("beta") == Symbol(1));
+        Check(symbols->Intern("") == 2 && symbols->Name(2).empty());
+
+        for (int i = 0; i < 10000; ++i)
+            symbols->Intern("name" + std::to_string(i));
+        Check(symbols->Size() == 10003 && symbols->Find("name9999") == Symbol(10002));
+        Check(symbols->Name(first) == "alpha" && firstName.data() == symbols->Name(first).data());
+
+        auto identifier = Identifier(symbols);
+        std::string input = "name42 rest";
+        auto result = identifier(input);
+        Check(result.Success() && result.GetResult() == 45 && result.GetPosition() == 6);
+        std::string leadingDigit = "1abc";
+        Check(!identifier(leadingDigit).Success());
+        std::string empty;
+        Check(!identifier(empty).Success());
+        std::string fresh = "x1";
+        result = identifier(fresh);
+        Check(result.Success() && symbols->Name(result.GetResult()) == "x1");
+    }
+
+    void TestParseEach()
+    {
+        using namespace prs;
+
+        int calls = 0;
+        Parser<int> counted = [&](const StringState& state, const std::string& string)
+        {
+            ++calls;
+            return (integer >> ~Char(','))(string, state.position);
+        };
+        std::string list = "1,2,3,x,4,";
+        auto each = ParseEach(counted, list);
+        auto iterator = each.begin();
+        Check(calls == 1 && *iterator == 1);
+        int sum = 0;
+        for (; iterator != std::default_sentinel; ++iterator)
+            sum += *iterator;
+        Check(sum == 6 && calls == 4 && each.GetPosition() == 6);
+
+        std::string tail = "1,2,";
+        int count = 0;
+        for (int value : ParseEach(integer >> ~Char(','), tail, 2))
+            count += value;
+        Check(count == 2);
+
+        std::string noProgress = "abc";
+        auto empty = ParseEach(whitespaces, noProgress);
+        Check(empty.begin() == std::default_sentinel && empty.GetPosition() == 0);
+
+        std::string blank;
+        Check(ParseEach(any, blank).begin() == std::default_sentinel);
+        static_assert(std::ranges::input_range<ParseEachView<int>>);
+    }
+
+    void TestOnDemand()
+    {
+        using namespace prs;
+
+        Arena arena;
+        auto record = OnDemandRecord(',');
+        std::string input = "7,\"a,b\",\"say \"\"hi\"\"\",2.5\r\nnext";
+        auto result = record(input);
+        Check(result.Success() && result.GetPosition() == static_cast<int>(input.find("next")));
+        LazyRecord& fields = result.GetResult();
+        Check(fields.Size() == 4 && fields.View(1) == "\"a,b\"" && fields.View(3) == "2.5");
+        Check(fields.Integer(0) == 7 && !fields.Integer(3).has_value() && fields.Double(3) == 2.5);
+        Check(fields.String(0, arena) == "7" && fields.String(1, arena) == "a,b" && fields.String(2, arena) == "say \"hi\"");
+        Check(fields.String(1, arena).data() == input.data() + 3);
+        Check(fields.Get(0, integer) == 7 && !fields.Get(1, integer).has_value());
+        Parser<std::string> rest = Many(any) | [](const std::vector<char>& characters)
+        {
+            return std::string(characters.begin(), characters.end());
+        };
+        Check(fields.Get(0, rest) == "7" && fields.Get(3, rest) == "2.5");
+
+        std::string bounds = "9223372036854775807,-9223372036854775808,9223372036854775808\n";
+        auto numbers = record(bounds).GetResult();
+        Check(numbers.Integer(0) == INT64_MAX && numbers.Integer(1) == INT64_MIN && !numbers.Integer(2).has_value());
+
+        std::string unclosed = "1,\"open\n";
+        Check(!record(unclosed).Success());
+        std::string junkAfterQuote = "\"a\"b,c\n";
+        Check(!record(junkAfterQuote).Success());
+        std::string three = "a,b,c\n";
+        Check(!OnDemandRecord(',', 2)(three).Success() && OnDemandRecord(',', 3)(three).Success());
+        std::string empty;
+        Check(!record(empty).Success());
+        std::string emptyFields = ",\n";
+        auto blank = record(emptyFields);
+        Check(blank.Success() && blank.GetResult().Size() == 2 && blank.GetResult().View(1).empty());
+        std::string singleQuotes = "'it''s';x\n";
+        auto custom = OnDemandRecord(';', -1, '\'')(singleQuotes);
+        Check(custom.Success() && custom.GetResult().String(0, arena) == "it's");
+    }
+
+    void TestColumns()
+    {
+        using namespace prs;
+
+        auto numbers = std::make_shared<Column<std::int64_t>>();
+        auto names = std::make_shared<StringColumn>();
+        Parser<Void> row = Into(numbers, integer) >> ~Char(',') >> Into(names, letters) >> ~Char('\n');
+        std::string input = "1,ab\n2,\n3,cd;\n";
+        auto result = Rows({ numbers, names }, row)(input);
+        Check(result.Success() && result.GetResult() == 2 && result.GetPosition() == 8);
+        Check(numbers->Values() == std::vector<std::int64_t>{ 1, 2 } && names->Size() == 2);
+        Check(names->Get(0) == "ab" && names->Get(1).empty() && names->Data() == "ab");
+
+        auto empty = std::make_shared<StringColumn>();
+        std::string text = "abc";
+        auto stalled = Rows({ empty }, Into(empty, whitespaces))(text);
+        Check(stalled.Success() && stalled.GetResult() == 0 && stalled.GetPosition() == 0 && empty->Size() == 0);
+
+        names->Truncate(1);
+        Check(names->Size() == 1 && names->Offsets().back() == 2);
+    }
+
+    void TestIntegerColumn()
+    {
+        using namespace prs;
+
+        auto column = IntegerColumn(',', '\n');
+        std::string input = "9223372036854775807,-9223372036854775808,9223372036854775808,-9223372036854775809,"
+            "007,0,-0,,12a,-,123456789012345678,1\r\nrest";
+        auto result = column(input);
+        Check(result.Success() && result.GetPosition() == static_cast<int>(input.find("\nrest")));
+        IntegerBatch& batch = result.GetResult();
+        Check(batch.Size() == 12);
+        Check(batch.IsValid(0) && batch.values[0] == INT64_MAX && batch.IsValid(1) && batch.values[1] == INT64_MIN);
+        for (size_t i : { 2, 3, 4, 7, 8, 9 })
+            Check(!batch.IsValid(i) && batch.values[i] == 0);
+        Check(batch.IsValid(5) && batch.IsValid(6) && batch.values[6] == 0);
+        Check(batch.IsValid(10) && batch.values[10] == 123456789012345678 && batch.IsValid(11) && batch.values[11] == 1);
+
+        std::string many;
+        for (int i = 0; i < 130; ++i)
+            many += std::to_string(i * 7919) + " ";
+        auto spaced = IntegerColumn(' ', ' ')(many);
+        Check(spaced.Success() && spaced.GetPosition() == static_cast<int>(many.length()) && spaced.GetResult().Size() == 130);
+        Check(spaced.GetResult().IsValid(129) && spaced.GetResult().values[129] == 129 * 7919);
+
+        std::string empty;
+        Check(!column(empty).Success());
+    }
+
+    /*
+    * Returns the timestamp a parser produces for the whole of text, or the epoch if it fails or leaves text unconsumed.
+    */
+    prs::Timestamp ParseAll(const prs::Parser<prs::Timestamp>& parser, const std::string& text)
+    {
+        auto result = parser(text);
+        if (!result.Success() || result.GetPosition() != static_cast<int>(text.length()))
+            return prs::Timestamp();
+        return result.GetResult();
+    }
+
+    void TestTimestamps()
+    {
+        using namespace prs;
+        using namespace std::chrono;
+
+        Timestamp leapDay = sys_days(2024y / February / 29);
+        Check(ParseAll(iso8601, "2024-02-29") == leapDay);
+        Check(!iso8601(std::string("2023-02-29")).Success() && !iso8601(std::string("2024-13-01")).Success());
+        Check(ParseAll(iso8601, "2024-02-29T12:30") == leapDay + 12h + 30min);
+        Check(ParseAll(iso8601, "2024-02-29T12:30:15.25+02:00") == leapDay + 10h + 30min + 15s + 250ms);
+        Check(ParseAll(iso8601, "2024-02-29T00:00:00-0130") == leapDay + 1h + 30min);
+        Check(ParseAll(iso8601, "2024-02-29T12:30:15.1234567891") == leapDay + 12h + 30min + 15s + 123456789ns);
+        Check(!iso8601(std::string("2024-02-29T24:00")).Success() && !iso8601(std::string("2024-02-29T12:30:15.")).Success());
+
+        Check(ParseAll(rfc3339, "2016-12-31T23:59:60Z") == sys_days(2017y / January / 1));
+        Check(ParseAll(rfc3339, "2024-02-29t12:00:00.5-00:30") == leapDay + 12h + 30min + 500ms);
+        Check(!rfc3339(std::string("2024-02-29T12:00:00")).Success() && !rfc3339(std::string("2024-02-29T12:00:00+0200")).Success());
+
+        Check(ParseAll(epoch, "1709296215.25") == Timestamp(1709296215s + 250ms));
+        Check(ParseAll(epoch, "-1.5") == Timestamp(-1500ms) && ParseAll(epoch, "0") == Timestamp());
+        Check(!epoch(std::string("12345678901")).Success() && !epoch(std::string("-")).Success());
+
+        Check(ParseAll(clf, "10/Oct/2000:13:55:36 -0700") == sys_days(2000y / October / 10) + 20h + 55min + 36s);
+        Check(!clf(std::string("10/Oct/2000:13:55:36 -07:0")).Success() && !clf(std::string("31/Feb/2000:13:55:36 +0000")).Success());
+
+        auto syslog = Rfc3164Timestamp(2024);
+        Check(ParseAll(syslog, "Feb  1 22:14:15") == sys_days(2024y / February / 1) + 22h + 14min + 15s);
+        Check(ParseAll(syslog, "Feb 29 00:00:00") == leapDay);
+        Check(!Rfc3164Timestamp(2023)(std::string("Feb 29 00:00:00")).Success() && !syslog(std::string("Fe  1 22:14:15")).Success());
+    }
+
+    void TestQuotedString()
+    {
+        using namespace prs;
+
+        auto arena = std::make_shared<Arena>();
+        auto json = QuotedString(arena);
+        for (size_t length = 0; length < 40; ++length)
+        {
+            std::string text = "\"" + std::string(length, 'x') + "\" tail";
+            auto result = json(text);
+            Check(result.Success() && result.GetResult().length() == length && result.GetPosition() == static_cast<int>(length) + 2);
+            Check(result.GetResult().data() == text.data() + 1);
+            std::string escaped = "\"" + std::string(length, 'x') + "\\\"\"";
+            result = json(escaped);
+            Check(result.Success() && result.GetResult() == std::string(length, 'x') + "\"");
+        }
+
+        std::string escapes = R"("a\/\b\f\n\r\t\"\\\u00e9\ud83d\ude00")";
+        auto result = json(escapes);
+        Check(result.Success() && result.GetResult() == "a/\b\f\n\r\t\"\\\xC3\xA9\xF0\x9F\x98\x80");
+        for (std::string invalid : { R"("\x")", R"("\ud83d")", R"("\ude00")", R"("\ud83d\u0041")", R"("\u12")", R"("open)", R"("\")" })
+            Check(!json(invalid).Success());
+        std::string notQuoted = "x\"\"";
+        Check(!json(notQuoted).Success());
+
+        auto verbatim = QuotedString(arena, '\'', '\\', EscapePolicy::Verbatim);
+        std::string single = R"('it\'s \q')";
+        result = verbatim(single);
+        Check(result.Success() && result.GetResult() == "it's q");
+
+        auto doubled = QuotedString(arena, '"', '\\', EscapePolicy::DoubledQuote);
+        std::string csv = R"("a ""b"" \c"",")";
+        result = doubled(csv);
+        Check(result.Success() && result.GetResult() == "a \"b\" \\c\"," && result.GetPosition() == 15);
+        std::string trailing = R"("""")";
+        result = doubled(trailing);
+        Check(result.Success() && result.GetResult() == "\"" && result.GetPosition() == 4);
+    }
+
+    std::string Base64(const std::vector<std::uint8_t>& bytes, const char* alphabet, bool padding)
+    {
+        std::string text;
+        for (size_t i = 0; i < bytes.size(); i += 3)
+        {
+            std::uint32_t group = bytes[i] << 16;
+            if (i + 1 < bytes.size())
+                group |= bytes[i + 1] << 8;
+            if (i + 2 < bytes.size())
+                group |= bytes[i + 2];
+            size_t count = std::min<size_t>(bytes.size() - i, 3) + 1;
+            for (size_t j = 0; j < 4; ++j)
+                if (j < count)
+                    text += alphabet[(group >> (18 - 6 * j)) & 0x3F];
+                else if (padding)
+                    text += '=';
+        }
+        return text;
+    }
+
+    void TestEncoding()
+    {
+        using namespace prs;
+
+        const char* standard = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        const char* url = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+        std::mt19937 generator(3);
+        for (size_t size = 1; size < 70; ++size)
+        {
+            std::vector<std::uint8_t> bytes(size);
+            for (auto& byte : bytes)
+                byte = static_cast<std::uint8_t>(generator());
+            std::string hex;
+            for (std::uint8_t byte : bytes)
+                hex += "0123456789abcdefABCDEF"[byte >> 4 < 10 || generator() % 2 == 0 ? byte >> 4 : (byte >> 4) + 6],
+                    hex += "0123456789abcdef"[byte & 0xF];
+            auto decoded = hexBytes(hex + "xyz");
+            Check(decoded.Success() && decoded.GetResult() == bytes && decoded.GetPosition() == static_cast<int>(hex.length()));
+
+            for (bool padding : { false, true })
+            {
+                std::string text = Base64(bytes, standard, padding);
+                decoded = base64Bytes(text + " ");
+                Check(decoded.Success() && decoded.GetResult() == bytes && decoded.GetPosition() == static_cast<int>(text.length()));
+                text = Base64(bytes, url, padding);
+                decoded = base64UrlBytes(text);
+                Check(decoded.Success() && decoded.GetResult() == bytes && decoded.GetPosition() == static_cast<int>(text.length()));
+            }
+        }
+
+        std::string oddHex = "0123456789abcdef0";
+        auto result = hexBytes(oddHex);
+        Check(!result.Success() && result.GetPosition() == 16);
+        std::string badInBlock = "0123456789abcdeg";
+        result = hexBytes(badInBlock);
+        Check(!result.Success() && result.GetPosition() == 14);
+        std::string noDigits = "xy";
+        Check(!hexBytes(noDigits).Success());
+
+        for (std::string padded : { "QQ==", "QUI=", "QUJD" })
+            Check(base64Bytes(padded).GetPosition() == 4);
+        std::string shortPadding = "QQ=";
+        result = base64Bytes(shortPadding);
+        Check(!result.Success() && result.GetPosition() == 3);
+        std::string extraPadding = "QUI==";
+        result = base64Bytes(extraPadding);
+        Check(result.Success() && result.GetPosition() == 4);
+        std::string paddingAfterGroup = "QUJD=";
+        result = base64Bytes(paddingAfterGroup);
+        Check(!result.Success() && result.GetPosition() == 4);
+        std::string danglingSextet = "QUJDR";
+        result = base64Bytes(danglingSextet);
+        Check(!result.Success() && result.GetPosition() == 4);
+        std::string urlInStandard = "QUJD-_";
+        result = base64Bytes(urlInStandard);
+        Check(result.Success() && result.GetResult().size() == 3 && result.GetPosition() == 4);
+        std::string nonAscii = "QUJDQUJDQUJDQUJ\xC3\x81";
+        result = base64Bytes(nonAscii);
+        Check(result.Success() && result.GetResult().size() == 11 && result.GetPosition() == 15);
+    }
+
+    void TestFields()
+    {
+        using namespace prs;
+
+        Parser<std::string> rest = Many(any) | [](const std::vector<char>& characters)
+        {
+            return std::string(characters.begin(), characters.end());
+        };
+        auto record = Fields(',', '"', rest, integer, rest);
+        std::string input = "greedy,42,\"quoted, too\"\r\nnext";
+        auto result = record(input);
+        Check(result.Success() && result.GetPosition() == static_cast<int>(input.find("next")));
+        Check(std::get<0>(result.GetResult()) == "greedy" && std::get<1>(result.GetResult()) == 42);
+        Check(std::get<2>(result.GetResult()) == "\"quoted, too\"");
+
+        std::string partial = "a,42x,b\n";
+        Check(!record(partial).Success());
+        std::string tooFew = "a,1\n";
+        Check(!record(tooFew).Success());
+        std::string tooMany = "a,1,b,c\n";
+        Check(!record(tooMany).Success());
+        std::string empty = ",0,\n";
+        result = record(empty);
+        Check(result.Success() && std::get<0>(result.GetResult()).empty() && std::get<2>(result.GetResult()).empty());
+
+        auto nested = Fields(';', '"', Fields(',', '\'', integer, rest), rest);
+        std::string inner = "7,x;y";
+        auto both = nested(inner);
+        Check(both.Success() && std::get<1>(std::get<0>(both.GetResult())) == "x" && std::get<1>(both.GetResult()) == "y");
+
+        static_assert(detail::RefersToInput<std::vector<Pair<int, std::string_view>>>::value);
+        static_assert(!detail::RefersToInput<std::tuple<int, std::string>>::value);
+
+        auto spans = FieldSpans(',', 3)(input);
+        Check(spans.Success() && spans.GetResult()[2] == "\"quoted, too\"");
+    }
+
+    void TestFixedWidth()
+    {
+        using namespace prs;
+
+        auto record = FixedWidth(FixedField<int>{ 5, integer }, FixedField<std::string>{ 6, letters }, FixedField<int>{ 3, integer });
+        std::string touching = "12345abcdef678\n";
+        auto result = record(touching);
+        Check(result.Success() && result.GetPosition() == 14);
+        Check(std::get<0>(result.GetResult()) == 12345 && std::get<1>(result.GetResult()) == "abcdef" && std::get<2>(result.GetResult()) == 678);
+        std::string padded = "   42 ab     7";
+        result = record(padded);
+        Check(result.Success() && std::get<0>(result.GetResult()) == 42 && std::get<1>(result.GetResult()) == "ab");
+        std::string partial = "4 2  ab     7";
+        Check(!record(partial).Success());
+        std::string inner = "   42 a b    7";
+        Check(!record(inner).Success());
+        std::string shortRecord = "12345abcdef67";
+        Check(!record(shortRecord).Success());
+
+        std::string records = "00001x\n#skip.\n00002y\n00003";
+        auto notComment = [](std::string_view text)
+        {
+            return text.front() != '#';
+        };
+        auto item = FixedWidth(FixedField<int>{ 5, digits | [](const std::string& text) { return std::stoi(text); } },
+            FixedField<std::string>{ 1, letters });
+        auto all = FixedWidthRecords(7, notComment, item)(records);
+        Check(all.Success() && all.GetResult().size() == 2 && all.GetPosition() == 21);
+
+        bool threw = false;
+        try
+        {
+            auto invalid = FixedWidthRecords(0, notComment, item);
+        }
+        catch (const std::invalid_argument&)
+        {
+            threw = true;
+        }
+        Check(threw);
+        threw = false;
+        try
+        {
+            auto invalid = FixedWidth(FixedField<int>{ -1, integer });
+        }
+        catch (const std::invalid_argument&)
+        {
+            threw = true;
+        }
+        Check(threw);
+    }
+
+    struct Options
+    {
+        int width = -1;
+        int widthLimit = -1;
+        std::string name = "default";
+    };
+
+    void TestPermutation()
+    {
+        using namespace prs;
+
+        auto options = Permutation<Options>(~Char(','), {
+            Required(std::string("width="), integer, &Options::width),
+            Optional(std::string("widthLimit="), integer, &Options::widthLimit),
+            Optional(std::string("name="), letters, &Options::name) });
+        std::string reordered = "name=abc,widthLimit=9,width=3;";
+        auto result = options(reordered);
+        Check(result.Success() && result.GetPosition() == 29);
+        Check(result.GetResult().width == 3 && result.GetResult().widthLimit == 9 && result.GetResult().name == "abc");
+
+        std::string minimal = "width=1,";
+        result = options(minimal);
+        Check(result.Success() && result.GetPosition() == 7 && result.GetResult().name == "default" && result.GetResult().widthLimit == -1);
+        std::string missing = "name=x";
+        Check(!options(missing).Success());
+        std::string repeated = "width=1,width=2";
+        Check(!options(repeated).Success());
+        std::string unknown = "width=1,height=2";
+        result = options(unknown);
+        Check(result.Success() && result.GetPosition() == 7);
+        std::string empty;
+        Check(!options(empty).Success());
+
+        bool threw = false;
+        try
+        {
+            auto invalid = Permutation<Options>(~Char(','), { Optional(std::string(), integer, &Options::width) });
+        }
+        catch (const std::invalid_argument&)
+        {
+            threw = true;
+        }
+        Check(threw);
+    }
+
+    void TestKeyDispatch()
+    {
+        using namespace prs;
+
+        std::vector<std::string> keys;
+        for (int i = 0; i < 300; ++i)
+            keys.push_back("key" + std::to_string(i));
+        PerfectHash table(keys);
+        bool allFound = true;
+        for (int i = 0; i < 300; ++i)
+            allFound = allFound && table.Find(keys[i]) == i;
+        Check(allFound && table.Find("key300") == -1 && table.Find("") == -1 && PerfectHash().Find("key0") == -1);
+        PerfectHash caseless({ "Content-Length", "Host" }, true);
+        Check(caseless.Find("content-LENGTH") == 0 && caseless.Find("HOST") == 1 && caseless.Find("Hosts") == -1);
+
+        bool threw = false;
+        try
+        {
+            PerfectHash duplicates({ "a", "A" }, true);
+        }
+        catch (const std::invalid_argument&)
+        {
+            threw = true;
+        }
+        Check(threw);
+
+        auto value = ~Char('=') >> integer;
+        auto dispatch = KeyDispatch<int>({ { "width", value }, { "height", value | [](int v) { return -v; } } });
+        std::string bare = "height=4";
+        auto result = dispatch(bare);
+        Check(result.Success() && result.GetResult() == -4 && result.GetPosition() == 8);
+        std::string quoted = "\"width\"=5";
+        result = dispatch(quoted);
+        Check(result.Success() && result.GetResult() == 5);
+        std::string unknown = "depth=1";
+        Check(!dispatch(unknown).Success());
+        std::string badValue = "width=x";
+        result = dispatch(badValue);
+        Check(!result.Success() && result.GetPosition() == 0);
+        std::string unclosed = "\"width=5";
+        Check(!dispatch(unclosed).Success());
+
+        auto skipping = KeyDispatch<int>({ { "width", value } }, value | [](int) { return 0; });
+        result = skipping(unknown);
+        Check(result.Success() && result.GetResult() == 0 && result.GetPosition() == 7);
+    }
+
+    void TestSeparated()
+    {
+        using namespace prs;
+
+        auto comma = Char(',');
+        std::string trailing = "1,2,3,;";
+        auto list = SepBy(integer, comma)(trailing);
+        Check(list.Success() && list.GetResult() == std::vector<int>{ 1, 2, 3 } && list.GetPosition() == 5);
+        auto endList = SepEndBy(integer, comma)(trailing);
+        Check(endList.Success() && endList.GetResult().size() == 3 && endList.GetPosition() == 6);
+        std::string none = ";";
+        Check(SepBy(integer, comma)(none).Success() && SepEndBy(integer, comma)(none).GetPosition() == 0);
+        Check(!SepBy1(integer, comma)(none).Success() && !SepEndBy1(integer, comma)(none).Success());
+        auto sum = SepBy(integer, comma, 0, [](int total, int value) { return total + value; })(trailing);
+        Check(sum.Success() && sum.GetResult() == 6 && sum.GetPosition() == 5);
+        auto endSum = SepEndBy(integer, comma, 0, [](int total, int value) { return total + value; })(trailing);
+        Check(endSum.Success() && endSum.GetResult() == 6 && endSum.GetPosition() == 6);
+
+        using Operator = std::function<int(int, int)>;
+        Parser<Operator> minus = Char('-') | [](char) { return Operator([](int a, int b) { return a - b; }); };
+        Parser<Operator> power = Char('^') | [](char) { return Operator([](int a, int b)
+        {
+            int result = 1;
+            for (int i = 0; i < b; ++i)
+                result *= a;
+            return result;
+        }); };
+        std::string difference = "10-3-2-";
+        auto left = ChainL1(integer, minus)(difference);
+        Check(left.Success() && left.GetResult() == 5 && left.GetPosition() == 6);
+        std::string exponent = "2^3^2";
+        auto right = ChainR1(integer, power)(exponent);
+        Check(right.Success() && right.GetResult() == 512 && right.GetPosition() == 5);
+        std::string single = "7";
+        Check(ChainL1(integer, minus)(single).GetResult() == 7 && ChainR1(integer, power)(single).GetResult() == 7);
+        std::string noTerm = "-x";
+        Check(!ChainL1(integer, minus)(noTerm).Success() && !ChainR1(integer, power)(noTerm).Success());
+
+        std::string longChain = "1";
+        for (int i = 0; i < 200000; ++i)
+            longChain += "^1";
+        auto deep = ChainR1(integer, power)(longChain);
+        Check(deep.Success() && deep.GetResult() == 1 && deep.GetPosition() == static_cast<int>(longChain.length()));
+    }
+
+    void TestBind()
+    {
+        using namespace prs;
+
+        int created = 0;
+        auto counted = [&](int count)
+        {
+            ++created;
+            return Parser<std::string>([count](const StringState& state, const std::string& string)
+            {
+                if (count < 0 || static_cast<int>(string.length()) - state.position < count)
+                    return Fail<std::string>(state.position);
+                return Success(state.position + count, string.substr(state.position, count));
+            });
+        };
+        auto prefix = integer >> ~Char(':');
+        std::string input = "3:abcdef";
+        auto result = Bind(prefix, counted)(input);
+        Check(result.Success() && result.GetResult() == "abc" && result.GetPosition() == 5);
+        result = (prefix >>= counted)(input);
+        Check(result.Success() && result.GetResult() == "abc" && created == 2);
+        std::string tooShort = "9:abc";
+        result = Bind(prefix, counted)(tooShort);
+        Check(!result.Success() && result.GetPosition() == 0);
+
+        created = 0;
+        auto cached = BindCached(prefix, counted, 4);
+        for (int i = 0; i < 3; ++i)
+            Check(cached(input).GetResult() == "abc");
+        Check(created == 1);
+        std::string large = "5:abcdef";
+        std::string negative = "-1:x";
+        for (int i = 0; i < 2; ++i)
+            Check(cached(large).GetResult() == "abcde" && !cached(negative).Success());
+        Check(created == 5);
+        result = cached(tooShort);
+        Check(!result.Success() && result.GetPosition() == 0);
+    }
+
+    void TestCoroutine()
+    {
+        using namespace prs;
+
+        auto keyValue = Coroutine([]() -> Coro<Pair<std::string, int>>
+        {
+            auto key = co_await letters;
+            co_await Char('=');
+            auto value = co_await integer;
+            co_return { key, value };
+        });
+        std::string input = "width=42;";
+        auto result = keyValue(input);
+        Check(result.Success() && result.GetResult().first == "width" && result.GetResult().second == 42 && result.GetPosition() == 8);
+        std::string bad = "width=x";
+        result = keyValue(bad);
+        Check(!result.Success() && result.GetPosition() == 0);
+
+        static Parser<Pair<std::string, int>> item = keyValue;
+        static Parser<Pair<std::string, int>> nextItem = Try(~Char(';') >> item, Pair<std::string, int>{ "", -1 });
+        auto list = Coroutine([]() -> Coro<int>
+        {
+            auto first = co_await item;
+            int sum = first.second;
+            while (true)
+            {
+                auto more = co_await nextItem;
+                if (more.second < 0)
+                    break;
+                sum += more.second;
+            }
+            co_return sum;
+        });
+        std::string pairs = "a=1;b=2;c=3;d";
+        auto sum = list(pairs);
+        Check(sum.Success() && sum.GetResult() == 6);
+
+        auto throwing = Coroutine([]() -> Coro<int>
+        {
+            co_await Char('x');
+            throw std::runtime_error("thrown inside a coroutine");
+        });
+        std::string x = "x";
+        bool threw = false;
+        try
+        {
+            (void)throwing(x);
+        }
+        catch (const std::runtime_error&)
+        {
+            threw = true;
+        }
+        Check(threw);
+
+        bool allParsed = true;
+        for (int i = 0; i < 100000; ++i)
+            allParsed = allParsed && keyValue(input).Success() && !keyValue(bad).Success();
+        Check(allParsed);
+    }
+
+    void TestRecovery()
+    {
+        using namespace prs;
+
+        auto errors = std::make_shared<ErrorLog>();
+        Parser<int> statement = integer >> ~Char(';');
+        auto statements = Many(Recover(errors, statement, ';'));
+        std::string input = "1;x;3;";
+        auto result = statements(input);
+        Check(result.Success() && result.GetPosition() == 6 && result.GetResult().size() == 3);
+        Check(result.GetResult()[0] == 1 && !result.GetResult()[1].has_value() && result.GetResult()[2] == 3);
+        Check(errors->Errors().size() == 1 && errors->Errors()[0].position == 2 && errors->Errors()[0].resumePosition == 4);
+
+        errors->Clear();
+        std::string unterminated = "1;xx";
+        result = statements(unterminated);
+        Check(result.Success() && result.GetPosition() == 4 && result.GetResult().size() == 2);
+        Check(errors->Errors().size() == 1 && errors->Errors()[0].resumePosition == 4);
+
+        errors->Clear();
+        auto toEnd = Many(Recover(errors, statement, String("END")));
+        std::string marked = "1;zzEND4;";
+        auto markedResult = toEnd(marked);
+        Check(markedResult.Success() && markedResult.GetPosition() == 9 && markedResult.GetResult().size() == 3);
+        Check(errors->Errors().size() == 1 && errors->Errors()[0].position == 2 && errors->Errors()[0].resumePosition == 7);
+
+        errors->Clear();
+        auto spaces = Many(Recover(errors, statement, Many(Char(' '))));
+        std::string noSpaces = "1;zz";
+        auto spacesResult = spaces(noSpaces);
+        Check(spacesResult.Success() && spacesResult.GetPosition() == 4);
+        Check(errors->Errors().size() == 2 && errors->Errors()[0].resumePosition == 3 && errors->Errors()[1].resumePosition == 4);
+
+        errors->Clear();
+        std::string empty;
+        Check(!Recover(errors, statement, ';')(empty).Success() && errors->Empty());
+    }
+
+    void TestExpectations()
+    {
+        using namespace prs;
+
+        auto expectations = std::make_shared<Expectations>();
+        Check(expectations->GetPosition() == -1 && expectations->Describe("") == "no errors");
+
+        Parser<Void> identifier = Label(expectations, ~AtLeastOne(letter), "identifier");
+        Parser<Void> number = Label(expectations, ~AtLeastOne(digit), "number");
+        Parser<Void> open = Label(expectations, ~Char('('), "'('");
+        Parser<Void> plus = Label(expectations, ~Char('+'), "'+'");
+        Parser<Void> operand = identifier || number || open;
+        Parser<Void> sum = operand >> plus >> operand;
+
+        std::string missingPlus = "a-";
+        Check(!sum(missingPlus).Success());
+        Check(expectations->GetPosition() == 1);
+        Check(expectations->Expected() == std::vector<std::string_view>{ "'+'" });
+
+        std::string earlier = "-";
+        Check(!operand(earlier).Success());
+        Check(expectations->GetPosition() == 1 && expectations->Expected().size() == 1);
+
+        std::string missingOperand = "a+-";
+        Check(!sum(missingOperand).Success());
+        Check(expectations->GetPosition() == 2);
+        Check(expectations->Expected() == std::vector<std::string_view>{ "identifier", "number", "'('" });
+        Check(expectations->Describe(missingOperand) == "line 1, column 3: expected identifier, number or '('");
+
+        expectations->Clear();
+        Parser<Void> lines = operand >> ~Char('\n') >> plus >> operand;
+        std::string secondLine = "x\n+";
+        Check(!lines(secondLine).Success());
+        Check(expectations->Describe(secondLine) == "line 2, column 2: expected identifier, number or '('");
+
+        expectations->Clear();
+        Check(expectations->GetPosition() == -1 && expectations->Expected().empty());
+        std::string valid = "a+1";
+        Check(sum(valid).Success());
+        Check(expectations->GetPosition() == 2 && expectations->Expected() == std::vector<std::string_view>{ "identifier" });
+    }
+
+    /*
+    * Resumes a parse until it finishes and returns the number of slices it took.
+    */
+    template<typename T>
+    int Slices(prs::InterruptibleParse<T>& parse)
+    {
+        int slices = 1;
+        while (!parse.Resume())
+            ++slices;
+        return slices;
+    }
+
+    void TestInterruptible()
+    {
+        using namespace prs;
+
+        std::string input(25, 'a');
+        auto as = Many(Checkpoint(Char('a')));
+        InterruptibleParse<std::vector<char>> parse(as, input, 10);
+        Check(Slices(parse) == 3);
+        Check(parse.GetResult().Success() && parse.GetResult().GetPosition() == 25 && parse.GetResult().GetResult().size() == 25);
+        Check(parse.Resume());
+
+        std::atomic<size_t> bound = 1;
+        Parser<std::vector<char>> scoped = [&](const StringState& state, const std::string& string)
+        {
+            detail::CancellationScope scope(bound, 0, 3);
+            return as(string, state.position);
+        };
+        InterruptibleParse<std::vector<char>> scopedParse(Checkpoint(scoped), input, 10);
+        Check(Slices(scopedParse) == 3 && scopedParse.GetResult().GetResult().size() == 25);
+
+        {
+            detail::CancellationScope scope(bound, 0, 3);
+            Check(as(input).Success());
+        }
+        Check(detail::stepBudget > std::numeric_limits<std::int64_t>::max() / 2);
+
+        std::thread::id caller = std::this_thread::get_id();
+        bool sameThread = true;
+        Parser<Void> recordThread = [&](const StringState& state, const std::string& string)
+        {
+            sameThread = sameThread && std::this_thread::get_id() == caller;
+            if (state.position >= static_cast<int>(string.length()))
+                return Fail<Void>(state.position);
+            return Success(state.position + 1, Void());
+        };
+        InterruptibleParse<std::vector<Void>> threadParse(Many(Checkpoint(recordThread) >> Checkpoint(recordThread)), input, 4);
+        Slices(threadParse);
+        Check(sameThread);
+
+        Parser<Void> throwing = [](const StringState& state, const std::string&) -> ParseResult<Void>
+        {
+            if (state.position == 12)
+                throw std::runtime_error("thrown inside an interruptible parse");
+            return Success(state.position + 1, Void());
+        };
+        InterruptibleParse<std::vector<Void>> throwingParse(Many(Checkpoint(throwing)), input, 5);
+        bool threw = false;
+        try
+        {
+            Slices(throwingParse);
+        }
+        catch (const std::runtime_error&)
+        {
+            threw = true;
+        }
+        Check(threw);
+
+        bool unwound = false;
+        {
+            struct Unwind
+            {
+                bool& flag;
+                ~Unwind() { flag = true; }
+            };
+            Parser<std::vector<char>> guarded = [&](const StringState& state, const std::string& string)
+            {
+                Unwind unwind{ unwound };
+                return as(string, state.position);
+            };
+            InterruptibleParse<std::vector<char>> abandoned(guarded, input, 5);
+            Check(!abandoned.Resume() && !unwound);
+        }
+        Check(unwound);
+    }
+
+    void TestParallelChoice()
+    {
+        using namespace prs;
+
+        ThreadPool pool(2);
+        auto choice = ParallelChoice({ String("abc"), String("ab"), String("a") }, pool);
+        auto sequential = String("abc") || String("ab") || String("a");
+        for (std::string input : { "abc", "abd", "axx", "b", "" })
+        {
+            auto parallel = choice(input);
+            auto expected = sequential(input);
+            Check(parallel.Success() == expected.Success() && parallel.GetPosition() == expected.GetPosition());
+            Check(!parallel.Success() || parallel.GetResult() == expected.GetResult());
+        }
+
+        Parser<std::string> throwing = [](const StringState&, const std::string&) -> ParseResult<std::string>
+        {
+            throw std::runtime_error("thrown by an alternative");
+        };
+        std::string a = "a";
+        auto shadowed = ParallelChoice({ String("a"), throwing }, pool)(a);
+        Check(shadowed.Success() && shadowed.GetResult() == "a");
+        bool threw = false;
+        try
+        {
+            (void)ParallelChoice({ String("b"), throwing, String("a") }, pool)(a);
+        }
+        catch (const std::runtime_error&)
+        {
+            threw = true;
+        }
+        Check(threw);
+
+        std::string manyAs(1 << 20, 'a');
+        Parser<std::string> slow = ~Many(Checkpoint(Char('a'))) >> String("!");
+        bool allFirst = true;
+        for (int i = 0; i < 20; ++i)
+        {
+            auto result = ParallelChoice({ String("aa"), slow }, pool)(manyAs);
+            allFirst = allFirst && result.Success() && result.GetPosition() == 2;
+        }
+        Check(allFirst);
+    }
+
+    void TestJson()
+    {
+        using namespace prs;
+
+        JsonParser json;
+        std::string document = " {\"a\": [1, 2.5, -3e2], \"b\": \"x\\ny\", \"c\": true, \"d\": null, \"e\": {}} ";
+        auto result = json(document);
+        Check(result.Success() && result.GetResult().type == JsonType::Object && result.GetResult().size == 5);
+        const JsonValue* a = result.GetResult().Find("a");
+        Check(a != nullptr && a->type == JsonType::Array && a->Array().size() == 3);
+        Check(a->Array()[0].Number() == 1 && a->Array()[1].Number() == 2.5 && a->Array()[2].Number() == -300);
+        const JsonValue* b = result.GetResult().Find("b");
+        Check(b != nullptr && b->String() == "x\ny");
+        Check(result.GetResult().Find("c")->Boolean() && result.GetResult().Find("d")->type == JsonType::Null);
+        Check(result.GetResult().Find("e")->type == JsonType::Object && result.GetResult().Find("e")->size == 0);
+        Check(result.GetResult().Find("f") == nullptr);
+
+        std::string deepest = std::string(JsonParser::maximumDepth, '[') + std::string(JsonParser::maximumDepth, ']');
+        Check(json(deepest).Success());
+        std::string tooDeep = std::string(JsonParser::maximumDepth + 1, '[') + std::string(JsonParser::maximumDepth + 1, ']');
+        Check(!json(tooDeep).Success());
+        std::string tooDeepObjects;
+        for (int i = 0; i <= JsonParser::maximumDepth; ++i)
+            tooDeepObjects += "{\"k\":";
+        tooDeepObjects += "0" + std::string(JsonParser::maximumDepth + 1, '}');
+        Check(!json(tooDeepObjects).Success());
+        Check(json(deepest).Success());
+
+        std::string huge = "1e400", negativeHuge = "-1e400", tiny = "1e-400";
+        Check(json(huge).Success() && std::isinf(json(huge).GetResult().Number()) && json(huge).GetResult().Number() > 0);
+        Check(json(negativeHuge).Success() && std::isinf(json(negativeHuge).GetResult().Number()) && json(negativeHuge).GetResult().Number() < 0);
+        Check(json(tiny).Success() && json(tiny).GetResult().Number() == 0);
+        for (std::string invalid : { "01", "1.", "-", ".5", "1e", "+1", "[1,]", "{\"a\" 1}", "[1] x", "tru", "" })
+            Check(!json(invalid).Success());
+
+        std::string rawTab = "\"a\tb\"", rawNewline = "[\"a\nb\"]", escapedTab = "\"a\\tb\"";
+        Check(!json(rawTab).Success() && !json(rawNewline).Success());
+        Check(json(escapedTab).Success() && json(escapedTab).GetResult().String() == "a\tb");
+        std::string rawKey = "{\"a\x01\": 1}";
+        Check(!json(rawKey).Success());
+    }
+
+    void TestThreadPool()
+    {
+        using namespace prs;
+
+        ThreadPool pool(3);
+        std::vector<int> calls(1000);
+        pool.ForEach(calls.size(), [&](size_t i) { ++calls[i]; });
+        Check(std::all_of(calls.begin(), calls.end(), [](int count) { return count == 1; }));
+        pool.ForEach(0, [&](size_t) { Check(false); });
+
+        ThreadPool single(1);
+        std::atomic<int> inner = 0;
+        single.ForEach(4, [&](size_t)
+        {
+            single.ForEach(4, [&](size_t) { ++inner; });
+        });
+        Check(inner == 16);
+
+        std::atomic<int> finished = 0;
+        bool threw = false;
+        try
+        {
+            pool.ForEach(100, [&](size_t i)
+            {
+                if (i == 10)
+                    throw std::runtime_error("thrown by one index");
+                ++finished;
+            });
+        }
+        catch (const std::runtime_error&)
+        {
+            threw = true;
+        }
+        Check(threw && finished == 99);
+    }
+
+    void TestCsv()
+    {
+        using namespace prs;
+
+        auto arena = std::make_shared<Arena>();
+        auto record = CsvRecord(arena);
+        std::string line = "a,\"b,c\",\"d\"\"e\",\n";
+        auto fields = record(line);
+        Check(fields.Success() && fields.GetPosition() == static_cast<int>(line.size()));
+        Check(fields.GetResult() == std::vector<std::string_view>{ "a", "b,c", "d\"e", "" });
+
+        auto csv = Csv(arena);
+        std::string crlf = "a,b\r\nc,d";
+        auto records = csv(crlf);
+        Check(records.Success() && records.GetResult().size() == 2);
+        Check(records.GetResult()[0] == std::vector<std::string_view>{ "a", "b" } && records.GetResult()[1] == std::vector<std::string_view>{ "c", "d" });
+        std::string multiline = "\"x\ny\",z\n";
+        records = csv(multiline);
+        Check(records.Success() && records.GetResult().size() == 1 && records.GetResult()[0][0] == "x\ny");
+        std::string unterminated = "a,\"b\n";
+        Check(!csv(unterminated).Success());
+
+        std::mt19937 generator(7);
+        std::string large;
+        while (large.size() < (6 << 20))
+        {
+            switch (generator() % 4)
+            {
+            case 0: large += "plain,"; break;
+            case 1: large += "\"with \"\"quotes\"\"\",\n"; break;
+            case 2: large += "\"line\nbreak\",x\n"; break;
+            default: large += std::to_string(generator()) + "\n"; break;
+            }
+        }
+        large += "end\n";
+        ThreadPool pool(3);
+        auto parallel = ParallelCsv(arena, pool)(large);
+        auto sequential = csv(large);
+        Check(parallel.Success() && sequential.Success() && parallel.GetResult() == sequential.GetResult());
+
+        auto first = std::make_shared<StringColumn>();
+        auto second = std::make_shared<StringColumn>();
+        auto columns = CsvColumns({ first, second });
+        std::string table = "a,1\n\"b\"\"\",2\nc\nd,4\n";
+        auto rows = columns(table);
+        Check(rows.Success() && rows.GetResult() == 2 && rows.GetPosition() == 12);
+        Check(first->Size() == 2 && second->Size() == 2 && first->Get(1) == "b\"" && second->Get(1) == "2");
+    }
+
+    void TestHttp()
+    {
+        using namespace prs;
+
+        auto head = HttpRequestHead();
+        std::string request = "POST /upload?x=1 HTTP/1.1\r\nHOST: example.com\r\ncontent-LENGTH:  12 \r\nX-Note:\ta\tb \t\r\n"
+            "X-Latin: caf\xC3\xA9\r\n\r\nbody follows";
+        auto result = head(request);
+        Check(result.Success() && result.GetPosition() == static_cast<int>(request.find("body")));
+        HttpRequest& parsed = result.GetResult();
+        Check(parsed.method == HttpMethod::Post && parsed.target == "/upload?x=1" && parsed.majorVersion == 1 && parsed.minorVersion == 1);
+        Check(parsed.fields.size() == 4 && parsed.Find(HttpHeader::Host) != nullptr && parsed.Find(HttpHeader::Host)->value == "example.com");
+        Check(parsed.Find(HttpHeader::ContentLength)->name == "content-LENGTH" && parsed.contentLength == 12 && !parsed.chunked);
+        Check(parsed.fields[2].header == HttpHeader::Other && parsed.fields[2].value == "a\tb");
+        Check(parsed.fields[3].value == "caf\xC3\xA9" && parsed.Find(HttpHeader::Cookie) == nullptr);
+
+        std::string custom = "BREW /pot HTTP/1.0\r\n\r\n";
+        auto customResult = head(custom);
+        Check(customResult.Success() && customResult.GetResult().method == HttpMethod::Other && customResult.GetResult().methodName == "BREW");
+        Check(customResult.GetResult().contentLength == -1 && customResult.GetResult().fields.empty());
+
+        for (std::string invalid : {
+            "GET / HTTP/1.1\r\nHost: a\x01b\r\n\r\n",
+            "GET / HTTP/1.1\r\nHost: a\x7F\r\n\r\n",
+            "GET / HTTP/1.1\nHost: a\r\n\r\n",
+            "GET / HTTP/1.1\r\nHost: a\n\r\n",
+            "GET / HTTP/1.1\r\nHost: a\r\n folded\r\n\r\n",
+            "GET / HTTP/1.1\r\nHost : a\r\n\r\n",
+            "GET / HTTP/1.1\r\nHost: a\r\n",
+            "GET /a b HTTP/1.1\r\n\r\n",
+            "GET / HTTP/11\r\n\r\n" })
+            Check(!head(invalid).Success());
+
+        auto framing = [&](const std::string& fields)
+        {
+            std::string text = "POST / HTTP/1.1\r\n" + fields + "\r\n";
+            return head(text);
+        };
+        Check(!framing("Content-Length: 5\r\nTransfer-Encoding: chunked\r\n").Success());
+        Check(!framing("Content-Length: 5x\r\n").Success());
+        Check(!framing("Content-Length: \r\n").Success());
+        Check(!framing("Content-Length: 5\r\nContent-Length: 6\r\n").Success());
+        Check(framing("Content-Length: 5\r\nContent-Length: 5\r\n").GetResult().contentLength == 5);
+        Check(framing("Transfer-Encoding: gzip, Chunked\r\n").GetResult().chunked);
+        Check(!framing("Transfer-Encoding: chunked, gzip\r\n").Success());
+
+        HttpLimits limits;
+        limits.maximumFields = 2;
+        limits.maximumFieldLine = 16;
+        auto limited = HttpRequestHead(limits);
+        std::string twoFields = "GET / HTTP/1.1\r\nA: 1\r\nB: 2\r\n\r\n", threeFields = "GET / HTTP/1.1\r\nA: 1\r\nB: 2\r\nC: 3\r\n\r\n";
+        std::string longField = "GET / HTTP/1.1\r\nA: 0123456789abcdef\r\n\r\n";
+        Check(limited(twoFields).Success() && !limited(threeFields).Success() && !limited(longField).Success());
+
+        auto line = HttpFieldLine();
+        std::string field = "Accept-Encoding: gzip\r\nrest";
+        auto fieldResult = line(field);
+        Check(fieldResult.Success() && fieldResult.GetPosition() == 23 && fieldResult.GetResult().header == HttpHeader::AcceptEncoding);
+        std::string empty = "\r\n";
+        Check(!line(empty).Success());
+    }
+    void TestLogs()
+    {
+        using namespace prs;
+        using namespace std::chrono;
+
+        std::string line = "<34>1 2003-10-11T22:14:15.003Z mymachine.example.com su - ID47 "
+            "[exampleSDID@32473 iut=\"3\" note=\"a \\\"b\\\" \\]\"][other] 'su root' failed\r\nnext";
+        auto message = syslog5424(line);
+        Check(message.Success() && message.GetPosition() == static_cast<int>(line.find("next")));
+        SyslogMessage& parsed = message.GetResult();
+        Check(parsed.facility == 4 && parsed.severity == 2 && parsed.version == 1);
+        Check(parsed.timestamp == sys_days(2003y / October / 11) + 22h + 14min + 15s + 3ms);
+        Check(parsed.hostname == "mymachine.example.com" && parsed.appName == "su" && parsed.processId.empty() && parsed.messageId == "ID47");
+        Check(parsed.structuredData == "[exampleSDID@32473 iut=\"3\" note=\"a \\\"b\\\" \\]\"][other]");
+        Check(parsed.message == "'su root' failed");
+
+        std::string nil = "<165>1 - - - - - -";
+        auto nilMessage = syslog5424(nil);
+        Check(nilMessage.Success() && nilMessage.GetPosition() == static_cast<int>(nil.length()));
+        Check(!nilMessage.GetResult().timestamp && nilMessage.GetResult().hostname.empty() && nilMessage.GetResult().structuredData.empty());
+        Check(nilMessage.GetResult().facility == 20 && nilMessage.GetResult().severity == 5 && nilMessage.GetResult().message.empty());
+
+        for (std::string invalid : {
+            "<192>1 - - - - - -\n",
+            "<01>1 - - - - - -\n",
+            "<1>0 - - - - - -\n",
+            "<1>1 - - - - - [id\n",
+            "<1>1 - - - - - [id x=\"1\n\"]\n",
+            "<1>1 - - - - - [id x=1]\n",
+            "<1>1 - - - - -x\n",
+            "<1>1 - - - -\n" })
+            Check(!syslog5424(invalid).Success());
+
+        auto bsd = Syslog3164(2024);
+        std::string tagged = "<13>Feb  1 22:14:15 db-01 sshd[4721]: Accepted key\n";
+        auto bsdMessage = bsd(tagged);
+        Check(bsdMessage.Success() && bsdMessage.GetPosition() == static_cast<int>(tagged.length()));
+        Check(bsdMessage.GetResult().timestamp == sys_days(2024y / February / 1) + 22h + 14min + 15s);
+        Check(bsdMessage.GetResult().hostname == "db-01" && bsdMessage.GetResult().appName == "sshd");
+        Check(bsdMessage.GetResult().processId == "4721" && bsdMessage.GetResult().message == "Accepted key");
+        std::string untagged = "<13>Feb  1 22:14:15 db-01 kernel[x]: panic\n";
+        auto untaggedMessage = bsd(untagged);
+        Check(untaggedMessage.Success() && untaggedMessage.GetResult().appName.empty() && untaggedMessage.GetResult().message == "kernel[x]: panic");
+        std::string bare = "<13>Feb  1 22:14:15 db-01 cron:run";
+        Check(bsd(bare).Success() && bsd(bare).GetResult().appName == "cron" && bsd(bare).GetResult().message == "run");
+        std::string noHost = "<13>Feb  1 22:14:15\n";
+        Check(!bsd(noHost).Success());
+
+        std::string combined = "127.0.0.1 - frank [10/Oct/2000:13:55:36 -0700] \"GET /apache_pb.gif HTTP/1.0\" 200 2326 "
+            "\"http://www.example.com/start.html\" \"Mozilla/4.08 [en] (Win98; I ;Nav)\"\n";
+        auto entry = combinedLog(combined);
+        Check(entry.Success() && entry.GetPosition() == static_cast<int>(combined.length()));
+        AccessLogEntry& access = entry.GetResult();
+        Check(access.remoteHost == "127.0.0.1" && access.identity == "-" && access.user == "frank");
+        Check(access.time == sys_days(2000y / October / 10) + 20h + 55min + 36s);
+        Check(access.method == "GET" && access.target == "/apache_pb.gif" && access.protocol == "HTTP/1.0");
+        Check(access.status == 200 && access.bytes == 2326 && access.referer == "http://www.example.com/start.html");
+        Check(access.userAgent == "Mozilla/4.08 [en] (Win98; I ;Nav)");
+
+        std::string common = "10.0.0.2 - - [10/Oct/2000:13:55:36 +0000] \"\\x16\\x03\" 400 -\r\n";
+        auto commonEntry = combinedLog(common);
+        Check(commonEntry.Success() && commonEntry.GetPosition() == static_cast<int>(common.length()));
+        Check(commonEntry.GetResult().request == "\\x16\\x03" && commonEntry.GetResult().method.empty());
+        Check(commonEntry.GetResult().bytes == -1 && commonEntry.GetResult().referer.empty());
+
+        for (std::string invalid : {
+            "a - - [10/Oct/2000:13:55:36 -0700] \"GET / HTTP/1.0\" 20 1\n",
+            "a - - [10/Oct/2000:13:55:36 -0700] \"GET / HTTP/1.0\" 200 x\n",
+            "a - - [10/Oct/2000:13:55:36 -0700] \"GET / HTTP/1.0\" 200 1 \"referer only\"\n",
+            "a - - [10/Oct/2000:13:55:36 -0700] \"GET / HTTP/1.0 200 1\n",
+            "a - - 10/Oct/2000:13:55:36 -0700 \"GET / HTTP/1.0\" 200 1\n",
+            "" })
+            Check(!combinedLog(invalid).Success());
+    }
+    /*
+    * Records the events of an XML document as text, such as <a x=1>text</a>.
+    */
+    class XmlRecorder : public prs::XmlHandler
+    {
+    public:
+        std::string events;
+
+        void StartElement(std::string_view name, std::span<const prs::XmlAttribute> attributes) override
+        {
+            events += "<" + std::string(name);
+            for (const prs::XmlAttribute& attribute : attributes)
+                events += " " + std::string(attribute.name) + "=" + std::string(attribute.value);
+            events += ">";
+        }
+
+        void EndElement(std::string_view name) override
+        {
+            events += "</" + std::string(name) + ">";
+        }
+
+        void Text(std::string_view text) override
+        {
+            events += "[" + std::string(text) + "]";
+        }
+    };
+
+    void TestXml()
+    {
+        using namespace prs;
+
+        auto parse = [](const std::string& document, std::string& events)
+        {
+            auto recorder = std::make_shared<XmlRecorder>();
+            auto result = Xml(recorder, std::make_shared<Arena>())(document);
+            events = recorder->events;
+            return result.Success() && result.GetPosition() == static_cast<int>(document.length());
+        };
+
+        std::string events;
+        Check(parse("\xEF\xBB\xBF<?xml version=\"1.0\"?>\n<!-- head --><root a=\"1\" b = 'x &amp; y'>t&lt;1&#x41;&#66;<empty/>"
+            "<child c=\"&quot;\">in</child ><![CDATA[<raw>&amp;]]><?pi data?><!--c--></root>\n<!-- tail -->\n", events));
+        Check(events == "<root a=1 b=x & y>[t<1AB]<empty></empty><child c=\">[in]</child>[<raw>&amp;]</root>");
+        Check(parse("<a/>", events) && events == "<a></a>");
+        Check(parse("<a>caf&#233;</a>", events) && events == "<a>[caf\xC3\xA9]</a>");
+
+        std::string deep;
+        for (int i = 0; i < 100000; ++i)
+            deep += "<d>";
+        for (int i = 0; i < 100000; ++i)
+            deep += "</d>";
+        Check(parse(deep, events));
+
+        for (std::string invalid : {
+            "<a></b>",
+            "<a>",
+            "<a x=1/>",
+            "<a x=\"1\"y=\"2\"/>",
+            "<a x=\"<\"/>",
+            "<a>&unknown;</a>",
+            "<a>&#0;</a>",
+            "<a>&#xD800;</a>",
+            "<a>&amp</a>",
+            "<!DOCTYPE a><a/>",
+            "<a/><b/>",
+            "<a><!-- open</a>",
+            "",
+            "text" })
+            Check(!parse(invalid, events));
+    }
+}
+
+int main()
+{
+    TestIndentation();
+    TestSymbols();
+    TestParseEach();
+    TestOnDemand();
+    TestColumns();
+    TestIntegerColumn();
+    TestTimestamps();
+    TestQuotedString();
+    TestEncoding();
+    TestFields();
+    TestFixedWidth();
+    TestPermutation();
+    TestKeyDispatch();
+    TestSeparated();
+    TestBind();
+    TestCoroutine();
+    TestRecovery();
+    TestExpectations();
+    TestInterruptible();
+    TestParallelChoice();
+    TestJson();
+    TestThreadPool();
+    TestCsv();
+    TestHttp();
+    TestLogs();
+    TestXml();
+    if (failures != 0)
+    {
+        std::cerr << failures << " checks failed\n";
+        return EXIT_FAILURE;
+    }
+    std::cout << "all checks passed\n";
+    return EXIT_SUCCESS;
+}
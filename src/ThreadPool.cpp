@@ -0,0 +1,104 @@
+#include "ThreadPool.h"
+#include <atomic>
+#include <memory>
+#include <exception>
+#include <algorithm>
+
+namespace prs
+{
+    ThreadPool::ThreadPool(size_t count)
+    {
+        if (count == 0)
+            count = std::thread::hardware_concurrency();
+        if (count == 0)
+            count = 1;
+        for (size_t i = 0; i < count; ++i)
+        {
+            workers.emplace_back([this]()
+            {
+                while (true)
+                {
+                    std::function<void()> job;
+                    {
+                        std::unique_lock lock(mutex);
+                        available.wait(lock, [this]() { return stopping || !jobs.empty(); });
+                        if (jobs.empty())
+                            return;
+                        job = std::move(jobs.front());
+                        jobs.pop_front();
+                    }
+                    job();
+                }
+            });
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        available.notify_all();
+        for (auto& worker : workers)
+            worker.join();
+    }
+
+    void ThreadPool::Submit(std::function<void()> job)
+    {
+        {
+            std::lock_guard lock(mutex);
+            jobs.push_back(std::move(job));
+        }
+        available.notify_one();
+    }
+
+    void ThreadPool::ForEach(size_t count, const std::function<void(size_t)>& work)
+    {
+        if (count == 0)
+            return;
+        struct State
+        {
+            std::atomic<size_t> next = 0;
+            size_t finished = 0;
+            std::exception_ptr exception;
+            std::mutex mutex;
+            std::condition_variable done;
+        };
+        auto state = std::make_shared<State>();
+        auto run = [state, count, &work]()
+        {
+            for (size_t i = state->next++; i < count; i = state->next++)
+            {
+                std::exception_ptr exception;
+                try
+                {
+                    work(i);
+                }
+                catch (...)
+                {
+                    exception = std::current_exception();
+                }
+                std::lock_guard lock(state->mutex);
+                if (exception && !state->exception)
+                    state->exception = exception;
+                if (++state->finished == count)
+                    state->done.notify_all();
+            }
+        };
+        size_t helpers = std::min(Size(), count - 1);
+        for (size_t i = 0; i < helpers; ++i)
+            Submit(run);
+        run();
+        std::unique_lock lock(state->mutex);
+        state->done.wait(lock, [&]() { return state->finished == count; });
+        if (state->exception)
+            std::rethrow_exception(state->exception);
+    }
+
+    ThreadPool& ThreadPool::Shared()
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+namespace prs
+{
+    /*
+    * A fixed set of worker threads that run submitted jobs in submission order.
+    */
+    class ThreadPool
+    {
+    private:
+        std::vector<std::thread> workers;
+        std::deque<std::function<void()>> jobs;
+        std::mutex mutex;
+        std::condition_variable available;
+        bool stopping = false;
+    public:
+        /*
+        * Starts the workers. A count of zero uses one worker per hardware thread.
+        */
+        explicit ThreadPool(size_t count = 0);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        void Submit(std::function<void()> job);
+
+        /*
+        * Calls work(i) for every i below count, on the workers and on the calling thread, and waits for all calls.
+        * The calling thread takes part, so this does not deadlock when it is itself a worker of the pool.
+        * The first exception thrown by work is rethrown once all calls have finished.
+        */
+        void ForEach(size_t count, const std::function<void(size_t)>& work);
+
+        size_t Size() const
+        {
+            return workers.size();
+        }
+
+        /*
+        * Returns a pool shared by the whole process.
+        */
+        static ThreadPool& Shared();
+    };
+}
+
+#endif
@@ -0,0 +1,323 @@
+#include "Timestamps.h"
+#include "Swar.h"
+
+namespace prs
+{
+    namespace
+    {
+        using namespace std::chrono;
+
+        bool IsDigit(char c)
+        {
+            return c >= '0' && c <= '9';
+        }
+
+        /*
+        * Converts eight ASCII digits, the word being assembled in memory order by the caller.
+        */
+        bool ParseEight(std::uint64_t word, std::uint32_t& value)
+        {
+            if (!swar::IsEightDigits(word))
+                return false;
+            value = swar::ParseEightDigits(word);
+            return true;
+        }
+
+        bool ParseScalar(const char* digits, int count, std::uint32_t& value)
+        {
+            value = 0;
+            for (int i = 0; i < count; ++i)
+            {
+                if (!IsDigit(digits[i]))
+                    return false;
+                value = value * 10 + (digits[i] - '0');
+            }
+            return true;
+        }
+
+        /*
+        * Parses YYYY-MM-DD from 10 available characters into the number of days since the epoch.
+        */
+        bool ParseDate(const char* p, sys_days& days)
+        {
+            if (p[4] != '-' || p[7] != '-')
+                return false;
+            std::uint32_t n;
+            if constexpr (swar::enabled)
+            {
+                std::uint64_t first = swar::Load(p);
+                std::uint64_t last = swar::Load(p + 2);
+                std::uint64_t word = (first & 0x00000000FFFFFFFFull) |
+                    ((first >> 8) & 0x0000FFFF00000000ull) |
+                    (last & 0xFFFF000000000000ull);
+                if (!ParseEight(word, n))
+                    return false;
+            }
+            else
+            {
+                std::uint32_t y, m, d;
+                if (!ParseScalar(p, 4, y) || !ParseScalar(p + 5, 2, m) || !ParseScalar(p + 8, 2, d))
+                    return false;
+                n = y * 10000 + m * 100 + d;
+            }
+            year_month_day date{ year(static_cast<int>(n / 10000)), month(n / 100 % 100), day(n % 100) };
+            if (!date.ok())
+                return false;
+            days = sys_days(date);
+            return true;
+        }
+
+        /*
+        * Parses HH:MM:SS from 8 available characters into the number of seconds since midnight.
+        */
+        bool ParseTime(const char* p, seconds& time)
+        {
+            if (p[2] != ':' || p[5] != ':')
+                return false;
+            std::uint32_t n;
+            if constexpr (swar::enabled)
+            {
+                std::uint64_t w = swar::Load(p);
+                std::uint64_t word = 0x3030ull |
+                    ((w & 0xFFFFull) << 16) |
+                    (((w >> 24) & 0xFFFFull) << 32) |
+                    (w & 0xFFFF000000000000ull);
+                if (!ParseEight(word, n))
+                    return false;
+            }
+            else
+            {
+                std::uint32_t h, m, s;
+                if (!ParseScalar(p, 2, h) || !ParseScalar(p + 3, 2, m) || !ParseScalar(p + 6, 2, s))
+                    return false;
+                n = h * 10000 + m * 100 + s;
+            }
+            std::uint32_t h = n / 10000, m = n / 100 % 100, s = n % 100;
+            if (h > 23 || m > 59 || s > 60)
+                return false;
+            time = hours(h) + minutes(m) + seconds(s);
+            return true;
+        }
+
+        /*
+        * Parses an optional fraction of a second starting with '.', keeping at most nanosecond precision.
+        * Returns the position after the fraction, or -1 if the '.' is not followed by a digit.
+        */
+        int ParseFraction(const std::string& string, int position, nanoseconds& fraction)
+        {
+            constexpr std::int64_t scale[] = { 1, 100000000, 10000000, 1000000, 100000, 10000, 1000, 100, 10, 1 };
+            fraction = nanoseconds(0);
+            int length = static_cast<int>(string.length());
+            if (position >= length || string[position] != '.')
+                return position;
+            int begin = ++position;
+            while (position < length && IsDigit(string[position]))
+                ++position;
+            int count = position - begin;
+            if (count == 0)
+                return -1;
+            if (count > 9)
+                count = 9;
+            std::uint64_t value;
+            swar::ParseDigits(string.data() + begin, count, string.data() + length, value);
+            fraction = nanoseconds(static_cast<std::int64_t>(value) * scale[count]);
+            return position;
+        }
+
+        /*
+        * Parses Z or an offset of the form +HH:MM, or also +HH and +HHMM when extended is set.
+        * Returns the position after the offset, or -1 if there is none.
+        */
+        int ParseOffset(const std::string& string, int position, bool extended, minutes& offset)
+        {
+            int length = static_cast<int>(string.length());
+            if (position >= length)
+                return -1;
+            char c = string[position];
+            if (c == 'Z' || c == 'z')
+            {
+                offset = minutes(0);
+                return position + 1;
+            }
+            if ((c != '+' && c != '-') || length - position < 3)
+                return -1;
+            const char* p = string.data() + position + 1;
+            std::uint32_t h, m = 0;
+            if (!ParseScalar(p, 2, h))
+                return -1;
+            position += 3;
+            if (length - position >= 3 && string[position] == ':' && ParseScalar(p + 3, 2, m))
+                position += 3;
+            else if (extended && length - position >= 2 && ParseScalar(p + 2, 2, m))
+                position += 2;
+            else if (!extended)
+                return -1;
+            if (h > 23 || m > 59)
+                return -1;
+            offset = hours(h) + minutes(m);
+            if (c == '-')
+                offset = -offset;
+            return position;
+        }
+
+        /*
+        * Parses an English month abbreviation such as Jan from 3 available characters.
+        */
+        bool ParseMonth(const char* p, month& result)
+        {
+            constexpr char names[] = "JanFebMarAprMayJunJulAugSepOctNovDec";
+            for (unsigned i = 0; i < 12; ++i)
+            {
+                if (p[0] == names[i * 3] && p[1] == names[i * 3 + 1] && p[2] == names[i * 3 + 2])
+                {
+                    result = month(i + 1);
+                    return true;
+                }
+            }
+            return false;
+        }
+    }
+
+    Parser<Timestamp> iso8601 = [](const StringState& state, const std::string& string)
+    {
+        int length = static_cast<int>(string.length());
+        int position = state.position;
+        sys_days date;
+        if (length - position < 10 || !ParseDate(string.data() + position, date))
+            return Fail<Timestamp>(state.position);
+        position += 10;
+        Timestamp result = date;
+        if (position == length || string[position] != 'T')
+            return Success(position, result);
+
+        ++position;
+        if (length - position < 5 || string[position + 2] != ':')
+            return Fail<Timestamp>(state.position);
+        seconds time;
+        nanoseconds fraction(0);
+        if (length - position >= 8 && string[position + 5] == ':')
+        {
+            if (!ParseTime(string.data() + position, time))
+                return Fail<Timestamp>(state.position);
+            position = ParseFraction(string, position + 8, fraction);
+            if (position < 0)
+                return Fail<Timestamp>(state.position);
+        }
+        else
+        {
+            std::uint32_t h, m;
+            const char* p = string.data() + position;
+            if (!ParseScalar(p, 2, h) || !ParseScalar(p + 3, 2, m) || h > 23 || m > 59)
+                return Fail<Timestamp>(state.position);
+            time = hours(h) + minutes(m);
+            position += 5;
+        }
+        result += time + fraction;
+
+        minutes offset;
+        int end = ParseOffset(string, position, true, offset);
+        if (end >= 0)
+        {
+            result -= offset;
+            position = end;
+        }
+        return Success(position, result);
+    };
+
+    Parser<Timestamp> rfc3339 = [](const StringState& state, const std::string& string)
+    {
+        int length = static_cast<int>(string.length());
+        int position = state.position;
+        sys_days date;
+        seconds time;
+        if (length - position < 20)
+            return Fail<Timestamp>(state.position);
+        const char* p = string.data() + position;
+        if (p[10] != 'T' && p[10] != 't' && p[10] != ' ')
+            return Fail<Timestamp>(state.position);
+        if (!ParseDate(p, date) || !ParseTime(p + 11, time))
+            return Fail<Timestamp>(state.position);
+
+        nanoseconds fraction;
+        position = ParseFraction(string, position + 19, fraction);
+        if (position < 0)
+            return Fail<Timestamp>(state.position);
+        minutes offset;
+        position = ParseOffset(string, position, false, offset);
+        if (position < 0)
+            return Fail<Timestamp>(state.position);
+        return Success(position, Timestamp(date) + time + fraction - offset);
+    };
+
+    Parser<Timestamp> epoch = [](const StringState& state, const std::string& string)
+    {
+        int length = static_cast<int>(string.length());
+        int position = state.position;
+        bool negative = position < length && string[position] == '-';
+        if (negative)
+            ++position;
+        int begin = position;
+        while (position < length && IsDigit(string[position]))
+            ++position;
+        int count = position - begin;
+        std::uint64_t value;
+        if (count == 0 || count > 10 ||
+            !swar::ParseDigits(string.data() + begin, count, string.data() + length, value) ||
+            value > 9223372035)
+            return Fail<Timestamp>(state.position);
+
+        nanoseconds fraction;
+        position = ParseFraction(string, position, fraction);
+        if (position < 0)
+            return Fail<Timestamp>(state.position);
+        nanoseconds sinceEpoch = seconds(static_cast<std::int64_t>(value)) + fraction;
+        if (negative)
+            sinceEpoch = -sinceEpoch;
+        return Success(position, Timestamp(sinceEpoch));
+    };
+
+    Parser<Timestamp> clf = [](const StringState& state, const std::string& string)
+    {
+        int length = static_cast<int>(string.length());
+        if (length - state.position < 26)
+            return Fail<Timestamp>(state.position);
+        const char* p = string.data() + state.position;
+        std::uint32_t d, y;
+        month m;
+        seconds time;
+        if (p[2] != '/' || p[6] != '/' || p[11] != ':' || p[20] != ' ' ||
+            !ParseScalar(p, 2, d) || !ParseMonth(p + 3, m) || !ParseScalar(p + 7, 4, y) || !ParseTime(p + 12, time))
+            return Fail<Timestamp>(state.position);
+        year_month_day date{ year(static_cast<int>(y)), m, day(d) };
+        minutes offset;
+        std::uint32_t h, n;
+        if (!date.ok() || (p[21] != '+' && p[21] != '-') || !ParseScalar(p + 22, 2, h) || !ParseScalar(p + 24, 2, n) || h > 23 || n > 59)
+            return Fail<Timestamp>(state.position);
+        offset = hours(h) + minutes(n);
+        if (p[21] == '-')
+            offset = -offset;
+        return Success(state.position + 26, Timestamp(sys_days(date)) + time - offset);
+    };
+
+    Parser<Timestamp> Rfc3164Timestamp(int year)
+    {
+        return [year](const StringState& state, const std::string& string)
+        {
+            int length = static_cast<int>(string.length());
+            if (length - state.position < 15)
+                return Fail<Timestamp>(state.position);
+            const char* p = string.data() + state.position;
+            month m;
+            std::uint32_t d;
+            seconds time;
+            if (p[3] != ' ' || p[6] != ' ' || !ParseMonth(p, m) || !ParseTime(p + 7, time))
+                return Fail<Timestamp>(state.position);
+            if (p[4] == ' ' ? !ParseScalar(p + 5, 1, d) : !ParseScalar(p + 4, 2, d))
+                return Fail<Timestamp>(state.position);
+            year_month_day date{ std::chrono::year(year), m, day(d) };
+            if (!date.ok())
+                return Fail<Timestamp>(state.position);
+            return Success(state.position + 15, Timestamp(sys_days(date)) + time);
+        };
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef TIMESTAMPS_H
+#define TIMESTAMPS_H
+
+#include <chrono>
+#include "Parser.h"
+
+namespace prs
+{
+    /*
+    * A point in time in UTC with nanosecond precision.
+    */
+    using Timestamp = std::chrono::sys_time<std::chrono::nanoseconds>;
+
+    /*
+    * Parses the extended format of ISO 8601: a date (2024-03-01), optionally followed by 'T' and a time
+    * with minutes (12:30), seconds (12:30:15) or fractional seconds (12:30:15.25), and optionally an offset (Z, +02, +0200 or +02:00).
+    * Times without an offset are taken to be in UTC.
+    */
+    extern Parser<Timestamp> iso8601;
+
+    /*
+    * Parses an RFC 3339 date-time such as 2024-03-01T12:30:15.25+02:00.
+    * The date and time may be separated by 'T', 't' or a space, and a leap second rolls over into the next minute.
+    */
+    extern Parser<Timestamp> rfc3339;
+
+    /*
+    * Parses a number of seconds since the Unix epoch with optional fractional seconds, such as 1709296215.25.
+    */
+    extern Parser<Timestamp> epoch;
+
+    /*
+    * Parses the timestamp of the Common Log Format used by Apache and Nginx, such as 10/Oct/2000:13:55:36 -0700.
+    */
+    extern Parser<Timestamp> clf;
+
+    /*
+    * Returns a parser for the timestamp of RFC 3164 syslog messages, such as "Oct 11 22:14:15" or "Oct  1 22:14:15",
+    * which does not contain a year, so the year is taken from the argument.
+    */
+    [[nodiscard]]
+    Parser<Timestamp> Rfc3164Timestamp(int year);
+}
+
+#endif
@@ -0,0 +1,322 @@
+#include "Xml.h"
+#include "Strings.h"
+#include "Scan.h"
+#include <vector>
+#include <cstring>
+
+namespace prs
+{
+    namespace
+    {
+        bool IsSpace(char c)
+        {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+        }
+
+        bool IsNameStart(char c)
+        {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == ':' || static_cast<unsigned char>(c) >= 0x80;
+        }
+
+        bool IsNameCharacter(char c)
+        {
+            return IsNameStart(c) || (c >= '0' && c <= '9') || c == '-' || c == '.';
+        }
+
+        /*
+        * Parses the reference following '&' at p up to end. Returns the position after the ';', or nullptr if the reference is invalid.
+        */
+        const char* DecodeReference(const char* p, const char* end, char*& out)
+        {
+            const char* semicolon = static_cast<const char*>(std::memchr(p, ';', end - p));
+            if (semicolon == nullptr)
+                return nullptr;
+            std::string_view name(p, semicolon - p);
+            if (name == "lt")
+                *out++ = '<';
+            else if (name == "gt")
+                *out++ = '>';
+            else if (name == "amp")
+                *out++ = '&';
+            else if (name == "apos")
+                *out++ = '\'';
+            else if (name == "quot")
+                *out++ = '"';
+            else if (name.length() >= 2 && name[0] == '#')
+            {
+                bool hexadecimal = name[1] == 'x';
+                size_t i = hexadecimal ? 2 : 1;
+                if (i == name.length() || name.length() - i > 8)
+                    return nullptr;
+                std::uint32_t codePoint = 0;
+                for (; i < name.length(); ++i)
+                {
+                    char c = name[i];
+                    std::uint32_t digit;
+                    if (c >= '0' && c <= '9')
+                        digit = c - '0';
+                    else if (hexadecimal && c >= 'a' && c <= 'f')
+                        digit = c - 'a' + 10;
+                    else if (hexadecimal && c >= 'A' && c <= 'F')
+                        digit = c - 'A' + 10;
+                    else
+                        return nullptr;
+                    codePoint = codePoint * (hexadecimal ? 16 : 10) + digit;
+                }
+                if (codePoint == 0 || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF))
+                    return nullptr;
+                out = detail::AppendUtf8(out, codePoint);
+            }
+            else
+                return nullptr;
+            return semicolon + 1;
+        }
+
+        /*
+        * Returns [begin, end) with its references decoded, or false if one is invalid.
+        * Text without references is returned as a view into the input. A decoded reference is never longer than the reference itself.
+        */
+        bool Decode(const char* begin, const char* end, Arena& arena, std::string_view& result)
+        {
+            const char* ampersand = scan::FindFirstOf(begin, end, '&', '&');
+            if (ampersand == end)
+            {
+                result = std::string_view(begin, end - begin);
+                return true;
+            }
+            char* buffer = static_cast<char*>(arena.Allocate(end - begin, 1));
+            char* out = buffer;
+            const char* p = begin;
+            while (ampersand != end)
+            {
+                std::memcpy(out, p, ampersand - p);
+                out += ampersand - p;
+                p = DecodeReference(ampersand + 1, end, out);
+                if (p == nullptr)
+                    return false;
+                ampersand = scan::FindFirstOf(p, end, '&', '&');
+            }
+            std::memcpy(out, p, end - p);
+            out += end - p;
+            result = std::string_view(buffer, out - buffer);
+            return true;
+        }
+
+        class XmlReader
+        {
+        private:
+            const char* end;
+            XmlHandler& handler;
+            Arena& arena;
+            std::vector<std::string_view> open;
+            std::vector<XmlAttribute> attributes;
+        public:
+            const char* p;
+
+            XmlReader(const std::string& string, int position, XmlHandler& handler, Arena& arena)
+                : end(string.data() + string.length()), handler(handler), arena(arena), p(string.data() + position) { }
+
+            bool StartsWith(std::string_view text) const
+            {
+                return static_cast<size_t>(end - p) >= text.length() && std::memcmp(p, text.data(), text.length()) == 0;
+            }
+
+            void SkipSpace()
+            {
+                while (p < end && IsSpace(*p))
+                    ++p;
+            }
+
+            bool Name(std::string_view& name)
+            {
+                const char* begin = p;
+                if (p == end || !IsNameStart(*p))
+                    return false;
+                while (p < end && IsNameCharacter(*p))
+                    ++p;
+                name = std::string_view(begin, p - begin);
+                return true;
+            }
+
+            /*
+            * Skips from p past the first occurrence of terminator.
+            */
+            bool SkipPast(std::string_view terminator)
+            {
+                std::string_view rest(p, end - p);
+                size_t index = rest.find(terminator);
+                if (index == std::string_view::npos)
+                    return false;
+                p += index + terminator.length();
+                return true;
+            }
+
+            /*
+            * Skips comments, processing instructions and whitespace, as allowed before and after the root element.
+            */
+            bool Miscellaneous()
+            {
+                while (true)
+                {
+                    SkipSpace();
+                    if (StartsWith("<!--"))
+                    {
+                        p += 4;
+                        if (!SkipPast("-->"))
+                            return false;
+                    }
+                    else if (StartsWith("<?"))
+                    {
+                        p += 2;
+                        if (!SkipPast("?>"))
+                            return false;
+                    }
+                    else
+                        return true;
+                }
+            }
+
+            bool AttributeValue(std::string_view& value)
+            {
+                if (p == end || (*p != '"' && *p != '\''))
+                    return false;
+                char quote = *p++;
+                const char* begin = p;
+                const char* close = scan::FindFirstOf(p, end, quote, '<');
+                if (close == end || *close == '<')
+                    return false;
+                p = close + 1;
+                return Decode(begin, close, arena, value);
+            }
+
+            /*
+            * Parses a start tag or empty-element tag after its '<'.
+            */
+            bool StartTag()
+            {
+                std::string_view name;
+                if (!Name(name))
+                    return false;
+                attributes.clear();
+                while (true)
+                {
+                    const char* before = p;
+                    SkipSpace();
+                    if (p == end)
+                        return false;
+                    if (*p == '>' || (*p == '/' && p + 1 < end && p[1] == '>'))
+                        break;
+                    XmlAttribute& attribute = attributes.emplace_back();
+                    if (p == before || !Name(attribute.name))
+                        return false;
+                    SkipSpace();
+                    if (p == end || *p++ != '=')
+                        return false;
+                    SkipSpace();
+                    if (!AttributeValue(attribute.value))
+                        return false;
+                }
+                handler.StartElement(name, attributes);
+                if (*p == '/')
+                {
+                    p += 2;
+                    handler.EndElement(name);
+                }
+                else
+                {
+                    ++p;
+                    open.push_back(name);
+                }
+                return true;
+            }
+
+            /*
+            * Parses an end tag after its "</".
+            */
+            bool EndTag()
+            {
+                std::string_view name;
+                if (!Name(name) || open.empty() || open.back() != name)
+                    return false;
+                SkipSpace();
+                if (p == end || *p++ != '>')
+                    return false;
+                open.pop_back();
+                handler.EndElement(name);
+                return true;
+            }
+
+            /*
+            * Parses the root element and everything it contains.
+            */
+            bool Element()
+            {
+                if (p == end || *p++ != '<' || !StartTag())
+                    return false;
+                while (!open.empty())
+                {
+                    const char* text = p;
+                    bool references = false;
+                    while ((p = scan::FindFirstOf(p, end, '<', '&')) != end && *p == '&')
+                    {
+                        references = true;
+                        ++p;
+                    }
+                    if (p == end)
+                        return false;
+                    if (p > text)
+                    {
+                        std::string_view decoded(text, p - text);
+                        if (references && !Decode(text, p, arena, decoded))
+                            return false;
+                        handler.Text(decoded);
+                    }
+
+                    ++p;
+                    bool valid;
+                    if (p < end && *p == '/')
+                    {
+                        ++p;
+                        valid = EndTag();
+                    }
+                    else if (StartsWith("!--"))
+                    {
+                        p += 3;
+                        valid = SkipPast("-->");
+                    }
+                    else if (StartsWith("![CDATA["))
+                    {
+                        p += 8;
+                        const char* begin = p;
+                        valid = SkipPast("]]>");
+                        if (valid && p - 3 > begin)
+                            handler.Text(std::string_view(begin, p - 3 - begin));
+                    }
+                    else if (StartsWith("?"))
+                    {
+                        ++p;
+                        valid = SkipPast("?>");
+                    }
+                    else
+                        valid = StartTag();
+                    if (!valid)
+                        return false;
+                }
+                return true;
+            }
+        };
+    }
+
+    Parser<Void> Xml(const std::shared_ptr<XmlHandler>& handler, const std::shared_ptr<Arena>& arena)
+    {
+        return [=](const StringState& state, const std::string& string)
+        {
+            XmlReader reader(string, state.position, *handler, *arena);
+            if (reader.StartsWith("\xEF\xBB\xBF"))
+                reader.p += 3;
+            if (!reader.Miscellaneous() || reader.StartsWith("<!") || !reader.Element() || !reader.Miscellaneous())
+                return Fail<Void>(state.position);
+            return Success(static_cast<int>(reader.p - string.data()), Void());
+        };
+    }
+}
@@ -0,0 +1,60 @@
+#ifndef XML_H
+#define XML_H
+
+#include <string>
+#include <string_view>
+#include <span>
+#include <memory>
+#include "Parser.h"
+#include "Arena.h"
+
+/*
+*
+* A parser for a subset of XML 1.0: elements, attributes, character data, CDATA sections, comments and processing instructions.
+* Document type declarations are rejected, so the only entities are the predefined ones and character references.
+*
+*/
+
+namespace prs
+{
+    struct XmlAttribute
+    {
+        std::string_view name;
+        std::string_view value;
+    };
+
+    /*
+    * Receives the content of a document in order. Names are views into the input, while text and attribute values
+    * are views into the input when they contain no references and otherwise decoded into the arena of the parser.
+    */
+    class XmlHandler
+    {
+    public:
+        virtual ~XmlHandler() = default;
+
+        /*
+        * Called for a start tag or an empty-element tag. The attributes are only valid during the call.
+        */
+        virtual void StartElement(std::string_view /*name*/, std::span<const XmlAttribute> /*attributes*/) { }
+
+        /*
+        * Called for an end tag, and directly after StartElement for an empty-element tag.
+        */
+        virtual void EndElement(std::string_view /*name*/) { }
+
+        /*
+        * Called for character data between markup, including whitespace, and for the content of a CDATA section.
+        */
+        virtual void Text(std::string_view /*text*/) { }
+    };
+
+    /*
+    * Returns a parser for a document with one root element, which reports its content to the handler as it is parsed.
+    * Markup and references are found sixteen characters at a time. Elements are tracked on a stack rather than by recursion,
+    * so deeply nested documents cannot exhaust the call stack. Events already reported are not withdrawn when the parser fails.
+    */
+    [[nodiscard]]
+    Parser<Void> Xml(const std::shared_ptr<XmlHandler>& handler, const std::shared_ptr<Arena>& arena);
+}
+
+#endif
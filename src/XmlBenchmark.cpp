@@ -0,0 +1,114 @@
+#include <string>
+#include <memory>
+#include <random>
+#include <cstdlib>
+#include <iostream>
+#include "Xml.h"
+#include "Benchmark.h"
+
+/*
+* Measures the XML parser against a grammar written naively from combinators, on a catalog of records with attributes,
+* nested elements, empty elements and indentation. The naive grammar only recognizes the document, while the parser
+* also reports every element and text to a handler. Not consumes the character it tests, so the naive text is Many(Not(Char('<'))).
+*/
+
+namespace
+{
+    std::mt19937 generator(5);
+
+    const char* words[] = { "parser", "combinator", "stream", "element", "value", "the", "of", "and", "memory", "input" };
+
+    std::string Sentence(int count)
+    {
+        std::string sentence;
+        for (int i = 0; i < count; ++i)
+        {
+            if (i > 0)
+                sentence += ' ';
+            sentence += words[generator() % 10];
+        }
+        return sentence;
+    }
+
+    std::string Document(size_t size)
+    {
+        std::string document = "<catalog>\n";
+        for (int id = 0; document.size() < size; ++id)
+        {
+            document += "  <book id=\"bk" + std::to_string(id) + "\" lang=\"en\">\n";
+            document += "    <author>" + Sentence(2) + "</author>\n";
+            document += "    <title>" + Sentence(4) + "</title>\n";
+            document += "    <price currency=\"EUR\">" + std::to_string(generator() % 100) + ".95</price>\n";
+            if (generator() % 2 == 0)
+                document += "    <available/>\n";
+            document += "    <description>" + Sentence(24) + "</description>\n";
+            document += "  </book>\n";
+        }
+        document += "</catalog>";
+        return document;
+    }
+
+    class CountingHandler : public prs::XmlHandler
+    {
+    public:
+        size_t events = 0;
+
+        void StartElement(std::string_view, std::span<const prs::XmlAttribute>) override
+        {
+            ++events;
+        }
+
+        void EndElement(std::string_view) override
+        {
+            ++events;
+        }
+
+        void Text(std::string_view) override
+        {
+            ++events;
+        }
+    };
+
+    prs::Parser<prs::Void> NaiveXml()
+    {
+        using namespace prs;
+
+        auto [element, elementRef] = CreateParserForwardedToRef<Void>();
+        Parser<Void> name = ~letters;
+        Parser<Void> text = ~AtLeastOne(Not(Char('<')));
+        Parser<Void> attribute = ~Char(' ') >> name >> ~Char('=') >> ~Char('"') >> ~Many(Not(Char('"'))) >> ~Char('"');
+        Parser<Void> startTag = ~Char('<') >> name >> ~Many(attribute);
+        Parser<Void> content = ~Many(text || element);
+        *elementRef = startTag >> (~String("/>") || (~Char('>') >> content >> ~String("</") >> name >> ~Char('>')));
+        return element;
+    }
+}
+
+int main()
+{
+    using namespace prs;
+
+    std::string document = Document(8 << 20);
+    double bytes = static_cast<double>(document.size());
+
+    auto handler = std::make_shared<CountingHandler>();
+    auto arena = std::make_shared<Arena>();
+    auto xml = Xml(handler, arena);
+    auto naive = NaiveXml();
+    if (xml(document).GetPosition() != static_cast<int>(document.size()) || naive(document).GetPosition() != static_cast<int>(document.size()))
+    {
+        std::cerr << "failed to parse the document\n";
+        return EXIT_FAILURE;
+    }
+
+    benchmark::ReportThroughput("Xml", benchmark::Time([&]()
+    {
+        benchmark::Keep(xml(document));
+        arena->Reset();
+    }), bytes);
+    benchmark::ReportThroughput("naive combinator grammar", benchmark::Time([&]()
+    {
+        benchmark::Keep(naive(document));
+    }), bytes);
+    return 0;
+}